@@ -0,0 +1,128 @@
+#include "ActiveEntitySet.h"
+#include "Entity.h"
+#include "Profiler.h"
+#include <typeinfo>
+
+ActiveEntitySet::ActiveEntitySet() {
+	this->nextOrder = 0;
+	this->cursor = -1;
+	this->currentTick = 0;
+}
+
+// Entities start awake; the ones that never tick are simply never added
+void ActiveEntitySet::add(Entity* entity) {
+	entity->setActiveOrder(this->nextOrder++);
+	this->awake.push_back(entity);
+}
+
+void ActiveEntitySet::clear() {
+	this->awake.clear();
+	this->alarms.clear();
+	this->alarmTicks.clear();
+	this->nextOrder = 0;
+}
+
+void ActiveEntitySet::update(double dt, Profiler* profiler) {
+	this->wakeAlarms();
+
+	// Indexed, since entities may wake or sleep while the loop runs
+	for (this->cursor = 0; this->cursor < (int)this->awake.size(); this->cursor++) {
+		Entity* entity = this->awake[this->cursor];
+
+		ProfileScope scope(profiler, typeid(*entity).name());
+		entity->update(dt);
+	}
+
+	this->cursor = -1;
+	this->currentTick++;
+}
+
+// An entity woken ahead of the one being updated runs later this same tick, as it would have if it never slept
+void ActiveEntitySet::wake(Entity* entity) {
+	if (entity->getActiveOrder() < 0 || this->isAwake(entity)) {
+		return;
+	}
+
+	int position = this->findPosition(entity);
+
+	this->cancelAlarm(entity);
+	this->awake.insert(this->awake.begin() + position, entity);
+
+	if (this->cursor >= 0 && position <= this->cursor) {
+		this->cursor++;
+	}
+}
+
+void ActiveEntitySet::sleep(Entity* entity) {
+	if (entity->getActiveOrder() < 0 || !this->isAwake(entity)) {
+		return;
+	}
+
+	int position = this->findPosition(entity);
+
+	this->awake.erase(this->awake.begin() + position);
+
+	if (this->cursor >= 0 && position <= this->cursor) {
+		this->cursor--;
+	}
+}
+
+// Skips the next given number of updates; the entity is updated again on the tick after them
+void ActiveEntitySet::sleepFor(Entity* entity, int ticks) {
+	if (ticks <= 0 || !this->isAwake(entity)) {
+		return;
+	}
+
+	this->sleep(entity);
+	this->alarms.push_back(entity);
+	this->alarmTicks.push_back(this->currentTick + ticks + 1);
+}
+
+bool ActiveEntitySet::isAwake(Entity* entity) {
+	int position = this->findPosition(entity);
+
+	return position < (int)this->awake.size() && this->awake[position] == entity;
+}
+
+int ActiveEntitySet::getAwakeCount() {
+	return (int)this->awake.size();
+}
+
+int ActiveEntitySet::findPosition(Entity* entity) {
+	int order = entity->getActiveOrder();
+	int low = 0;
+	int high = (int)this->awake.size();
+
+	while (low < high) {
+		int middle = (low + high) / 2;
+
+		if (this->awake[middle]->getActiveOrder() < order) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+void ActiveEntitySet::cancelAlarm(Entity* entity) {
+	for (size_t i = 0; i < this->alarms.size(); i++) {
+		if (this->alarms[i] == entity) {
+			this->alarms[i] = this->alarms.back();
+			this->alarmTicks[i] = this->alarmTicks.back();
+			this->alarms.pop_back();
+			this->alarmTicks.pop_back();
+			return;
+		}
+	}
+}
+
+void ActiveEntitySet::wakeAlarms() {
+	for (int i = (int)this->alarms.size() - 1; i >= 0; i--) {
+		if (this->alarmTicks[i] <= this->currentTick) {
+			this->wake(this->alarms[i]);
+		}
+	}
+}
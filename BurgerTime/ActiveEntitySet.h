@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include "SDL.h"
+
+class Entity;
+class Profiler;
+
+// The entities Game::update ticks. They keep the order they were added in, so waking or sleeping one
+// never changes the order the others run. A sleeping entity is still animated and rendered, it only
+// skips its updates until something wakes it or the tick it asked for comes round
+class ActiveEntitySet {
+	std::vector<Entity*> awake;
+	std::vector<Entity*> alarms;
+	std::vector<Uint32> alarmTicks;
+	int nextOrder;
+	int cursor;
+	Uint32 currentTick;
+
+public:
+	ActiveEntitySet();
+
+	void add(Entity* entity);
+	void clear();
+	void update(double dt, Profiler* profiler);
+
+	void wake(Entity* entity);
+	void sleep(Entity* entity);
+	void sleepFor(Entity* entity, int ticks);
+	bool isAwake(Entity* entity);
+	int getAwakeCount();
+
+private:
+	int findPosition(Entity* entity);
+	void cancelAlarm(Entity* entity);
+	void wakeAlarms();
+};
@@ -0,0 +1,37 @@
+#include "ArenaObject.h"
+#include "LevelArena.h"
+#include <new>
+
+// Every block starts with a header naming the arena it came from, or nullptr for the heap
+struct ArenaHeader {
+	LevelArena* arena;
+	size_t padding;
+};
+
+void* ArenaObject::operator new(size_t size) {
+	LevelArena* arena = LevelArena::getCurrent();
+	ArenaHeader* header;
+
+	if (arena != nullptr) {
+		header = (ArenaHeader*) arena->allocate(sizeof(ArenaHeader) + size);
+	}
+	else {
+		header = (ArenaHeader*) ::operator new(sizeof(ArenaHeader) + size);
+	}
+
+	header->arena = arena;
+
+	return header + 1;
+}
+
+void ArenaObject::operator delete(void* pointer) {
+	if (pointer == nullptr) {
+		return;
+	}
+
+	ArenaHeader* header = (ArenaHeader*) pointer - 1;
+
+	if (header->arena == nullptr) {
+		::operator delete(header);
+	}
+}
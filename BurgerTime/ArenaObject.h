@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+
+class LevelArena;
+
+// Base for the small objects a level creates. While a LevelArenaScope is active they are carved out
+// of that arena and their delete only runs the destructor; outside one they come from the heap
+class ArenaObject {
+public:
+	static void* operator new(size_t size);
+	static void operator delete(void* pointer);
+};
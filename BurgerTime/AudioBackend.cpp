@@ -0,0 +1,3 @@
+#include "AudioBackend.h"
+
+AudioBackend::~AudioBackend() { }
@@ -0,0 +1,18 @@
+#pragma once
+#include "SDL_mixer.h"
+
+class AudioBackend {
+public:
+	virtual Mix_Music* loadMusic(const char* path) = 0;
+	virtual Mix_Chunk* loadEffect(const char* path) = 0;
+	virtual void freeMusic(Mix_Music* music) = 0;
+	virtual void freeEffect(Mix_Chunk* effect) = 0;
+
+	virtual void playMusic(Mix_Music* music) = 0;
+	virtual void pauseMusic() = 0;
+	virtual void resumeMusic() = 0;
+	virtual void rewindMusic() = 0;
+	virtual void playEffect(Mix_Chunk* effect) = 0;
+
+	virtual ~AudioBackend();
+};
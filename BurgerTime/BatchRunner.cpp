@@ -0,0 +1,63 @@
+#include "BatchRunner.h"
+#include "LevelManager.h"
+#include "Engine.h"
+#include "Game.h"
+#include <thread>
+#include <vector>
+
+BatchRunner::BatchRunner(const char* levelPath, long ticksPerSession, Uint64 baseSeed) {
+	this->level = LevelManager::parseLevel(levelPath);
+	this->ticksPerSession = ticksPerSession;
+	this->baseSeed = baseSeed;
+}
+
+BatchResult BatchRunner::run(int workers, long sessions) {
+	std::vector<std::thread> threads;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	this->nextSession = 0;
+	this->totalTicks = 0;
+
+	for (int i = 0; i < workers; i++) {
+		threads.push_back(std::thread(&BatchRunner::work, this, sessions));
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	return { workers, sessions, this->totalTicks, seconds };
+}
+
+void BatchRunner::work(long sessions) {
+	long ticks = 0;
+
+	for (long index = this->nextSession++; index < sessions; index = this->nextSession++) {
+		ticks += this->runSession(index);
+	}
+
+	this->totalTicks += ticks;
+}
+
+long BatchRunner::runSession(long index) {
+	Engine engine;
+	Game* game = new Game(&engine);
+	long tick = 0;
+
+	engine.setSeed(this->baseSeed + index);
+	game->setSharedLevel(this->level);
+
+	if (engine.initHeadless(game)) {
+		for (tick = 0; tick < this->ticksPerSession && engine.update(); tick++);
+	}
+
+	delete game;
+
+	return tick;
+}
+
+BatchRunner::~BatchRunner() {
+	delete this->level;
+}
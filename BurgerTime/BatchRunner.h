@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include "SDL.h"
+#include "LevelData.h"
+
+struct BatchResult {
+	int workers;
+	long sessions;
+	long ticks;
+	double seconds;
+};
+
+class BatchRunner {
+	LevelData* level;
+	long ticksPerSession;
+	Uint64 baseSeed;
+
+	std::atomic<long> nextSession;
+	std::atomic<long> totalTicks;
+
+public:
+	BatchRunner(const char* levelPath, long ticksPerSession, Uint64 baseSeed);
+
+	BatchResult run(int workers, long sessions);
+
+	~BatchRunner();
+
+private:
+	void work(long sessions);
+	long runSession(long index);
+};
@@ -1,14 +0,0 @@
-#pragma once
-#include "Coordinate.h"
-
-class BoundingBox {
-	Coordinate* boxSize;
-
-public:
-	BoundingBox(Coordinate* boxSize);
-
-	bool isIntersecting(Coordinate* thisCenter, Coordinate* targetCenter, BoundingBox* boundingBox);
-
-	~BoundingBox();
-};
-
@@ -1,21 +1,31 @@
 #include "BoxCollideComponent.h"
-#include "BoundingBox.h"
+#include "Engine.h"
 #include <cmath>
 
+// A short list is tested collider by collider, with no broadphase to keep up to date
 BoxCollideComponent::BoxCollideComponent(Engine* engine, Entity* entity, Message message, std::vector<Entity*>* potentialColliders) : Component(engine, entity) {
 	this->colliders = potentialColliders;
+	this->bodies = nullptr;
+	this->group = BODY_GROUPS;
+	this->message = message;
+}
+
+BoxCollideComponent::BoxCollideComponent(Engine* engine, Entity* entity, Message message, SweepAndPrune* bodies, BodyGroup group) : Component(engine, entity) {
+	this->colliders = nullptr;
+	this->bodies = bodies;
+	this->group = group;
 	this->message = message;
 }
 
 void BoxCollideComponent::update(double dt) {
-	for (Entity* collider : *this->colliders) {
-		if (this->entity != collider) {
-			BoundingBox* thisBox = this->entity->getBoundingBox();
-			BoundingBox* otherBox = collider->getBoundingBox();
+	const std::vector<Entity*>& candidates = this->colliders != nullptr ? *this->colliders : this->bodies->query(this->entity, this->group);
 
-			if (thisBox->isIntersecting(this->entity->getPosition(), collider->getPosition(), otherBox)) {
+	for (Entity* collider : candidates) {
+		// Hidden colliders, like the pepper between throws, are out of the game
+		if (this->entity != collider && collider->getEnabled()) {
+			if (this->entity->isIntersecting(collider)) {
 				this->entity->receive(this->message);
-				collider->receive(this->message);
+				this->engine->getMessageDispatcher()->sendTo(collider, this->message);
 			}
 		}
 	}
@@ -3,15 +3,19 @@
 #include "Coordinate.h"
 #include "Component.h"
 #include <vector>
+#include "SweepAndPrune.h"
 
 class Component;
 
 class BoxCollideComponent : public Component {
 	std::vector<Entity*>* colliders;
+	SweepAndPrune* bodies;
+	BodyGroup group;
 	Message message;
 
 public:
 	BoxCollideComponent(Engine* engine, Entity* entity, Message message, std::vector<Entity*>* potentialColliders);
+	BoxCollideComponent(Engine* engine, Entity* entity, Message message, SweepAndPrune* bodies, BodyGroup group);
 
 	virtual void update(double dt);
 };
\ No newline at end of file
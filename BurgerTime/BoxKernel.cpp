@@ -0,0 +1,161 @@
+#include "BoxKernel.h"
+#include "PerformanceCounters.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BOX_KERNEL_X86
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BOX_KERNEL_AVX_TARGET
+#else
+#define BOX_KERNEL_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+BoxIntersector BoxKernel::chosen = BoxKernel::choose();
+const char* BoxKernel::chosenName;
+
+void BoxKernel::intersect(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	PerformanceCounters::collisionTests += boxes.count;
+
+	chosen(x, y, width, height, boxes, hits);
+}
+
+const char* BoxKernel::getPathName() {
+	return chosenName;
+}
+
+// Bits for the boxes from first up to last, which must all fall in one word of the mask
+static Uint64 intersectRun(double x, double y, double width, double height, const PackedBoxes& boxes, int first, int last, int base) {
+	Uint64 bits = 0;
+
+	for (int i = first; i < last; i++) {
+		bool overlapX = std::abs(x - boxes.x[i]) * 2 < width + boxes.width[i];
+		bool overlapY = std::abs(y - boxes.y[i]) * 2 < height + boxes.height[i];
+
+		bits |= (Uint64)(overlapX & overlapY) << (i - base);
+	}
+
+	return bits;
+}
+
+void BoxKernel::intersectScalar(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	for (int base = 0; base < boxes.count; base += 64) {
+		hits[base / 64] = intersectRun(x, y, width, height, boxes, base, std::min(base + 64, boxes.count), base);
+	}
+}
+
+#ifdef BOX_KERNEL_X86
+
+// Clearing the sign bit is the same abs as std::abs, and doubling by an add is exact, so lanes give
+// the scalar result bit for bit. Each word of the mask is built in a register and stored once
+void BoxKernel::intersectSse2(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	__m128d sign = _mm_set1_pd(-0.0);
+	__m128d queryX = _mm_set1_pd(x);
+	__m128d queryY = _mm_set1_pd(y);
+	__m128d queryWidth = _mm_set1_pd(width);
+	__m128d queryHeight = _mm_set1_pd(height);
+
+	for (int base = 0; base < boxes.count; base += 64) {
+		int last = std::min(base + 64, boxes.count);
+		int vectorLast = base + ((last - base) & ~1);
+		Uint64 bits = 0;
+
+		for (int i = base; i < vectorLast; i += 2) {
+			__m128d distanceX = _mm_andnot_pd(sign, _mm_sub_pd(queryX, _mm_loadu_pd(boxes.x + i)));
+			__m128d distanceY = _mm_andnot_pd(sign, _mm_sub_pd(queryY, _mm_loadu_pd(boxes.y + i)));
+			__m128d overlapX = _mm_cmplt_pd(_mm_add_pd(distanceX, distanceX), _mm_add_pd(queryWidth, _mm_loadu_pd(boxes.width + i)));
+			__m128d overlapY = _mm_cmplt_pd(_mm_add_pd(distanceY, distanceY), _mm_add_pd(queryHeight, _mm_loadu_pd(boxes.height + i)));
+
+			bits |= (Uint64)_mm_movemask_pd(_mm_and_pd(overlapX, overlapY)) << (i - base);
+		}
+
+		hits[base / 64] = bits | intersectRun(x, y, width, height, boxes, vectorLast, last, base);
+	}
+}
+
+BOX_KERNEL_AVX_TARGET
+void BoxKernel::intersectAvx(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	__m256d sign = _mm256_set1_pd(-0.0);
+	__m256d queryX = _mm256_set1_pd(x);
+	__m256d queryY = _mm256_set1_pd(y);
+	__m256d queryWidth = _mm256_set1_pd(width);
+	__m256d queryHeight = _mm256_set1_pd(height);
+
+	for (int base = 0; base < boxes.count; base += 64) {
+		int last = std::min(base + 64, boxes.count);
+		int vectorLast = base + ((last - base) & ~3);
+		Uint64 bits = 0;
+
+		for (int i = base; i < vectorLast; i += 4) {
+			__m256d distanceX = _mm256_andnot_pd(sign, _mm256_sub_pd(queryX, _mm256_loadu_pd(boxes.x + i)));
+			__m256d distanceY = _mm256_andnot_pd(sign, _mm256_sub_pd(queryY, _mm256_loadu_pd(boxes.y + i)));
+			__m256d overlapX = _mm256_cmp_pd(_mm256_add_pd(distanceX, distanceX), _mm256_add_pd(queryWidth, _mm256_loadu_pd(boxes.width + i)), _CMP_LT_OQ);
+			__m256d overlapY = _mm256_cmp_pd(_mm256_add_pd(distanceY, distanceY), _mm256_add_pd(queryHeight, _mm256_loadu_pd(boxes.height + i)), _CMP_LT_OQ);
+
+			bits |= (Uint64)_mm256_movemask_pd(_mm256_and_pd(overlapX, overlapY)) << (i - base);
+		}
+
+		hits[base / 64] = bits | intersectRun(x, y, width, height, boxes, vectorLast, last, base);
+	}
+}
+
+bool BoxKernel::isSse2Supported() {
+	return true;
+}
+
+// The CPU has to have AVX and the OS has to save the wide registers on a task switch
+bool BoxKernel::isAvxSupported() {
+#if defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 1);
+
+	bool avx = (info[2] & (1 << 28)) != 0;
+	bool osSavesRegisters = (info[2] & (1 << 27)) != 0;
+
+	return avx && osSavesRegisters && (_xgetbv(0) & 6) == 6;
+#else
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx");
+#endif
+}
+
+#else
+
+void BoxKernel::intersectSse2(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	intersectScalar(x, y, width, height, boxes, hits);
+}
+
+void BoxKernel::intersectAvx(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits) {
+	intersectScalar(x, y, width, height, boxes, hits);
+}
+
+bool BoxKernel::isSse2Supported() {
+	return false;
+}
+
+bool BoxKernel::isAvxSupported() {
+	return false;
+}
+
+#endif
+
+BoxIntersector BoxKernel::choose() {
+	if (isAvxSupported()) {
+		chosenName = "avx";
+		return intersectAvx;
+	}
+
+	if (isSse2Supported()) {
+		chosenName = "sse2";
+		return intersectSse2;
+	}
+
+	chosenName = "scalar";
+	return intersectScalar;
+}
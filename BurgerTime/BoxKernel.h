@@ -0,0 +1,35 @@
+#pragma once
+#include "SDL.h"
+
+// Boxes laid out like the registry keeps them: centres and full sizes in separate arrays
+struct PackedBoxes {
+	const double* x;
+	const double* y;
+	const double* width;
+	const double* height;
+	int count;
+};
+
+typedef void (*BoxIntersector)(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits);
+
+// Tests one box against a run of packed boxes, a few at a time where the CPU allows. Bit i of hits is
+// set when box i overlaps, by the same test as EntityRegistry::isIntersecting, so every path agrees
+// with it exactly. hits must hold (count + 63) / 64 words. The fastest path the CPU supports is picked
+// once at startup; the others stay public for the bench
+class BoxKernel {
+	static BoxIntersector chosen;
+	static const char* chosenName;
+
+public:
+	static void intersect(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits);
+	static const char* getPathName();
+
+	static void intersectScalar(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits);
+	static void intersectSse2(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits);
+	static void intersectAvx(double x, double y, double width, double height, const PackedBoxes& boxes, Uint64* hits);
+	static bool isSse2Supported();
+	static bool isAvxSupported();
+
+private:
+	static BoxIntersector choose();
+};
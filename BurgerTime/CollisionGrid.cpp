@@ -0,0 +1,143 @@
+#include "CollisionGrid.h"
+#include "Engine.h"
+#include "EntityRegistry.h"
+#include "Constants.h"
+#include <cmath>
+
+CollisionGrid::CollisionGrid(Engine* engine, std::vector<Entity*>* colliders) {
+	this->registry = engine->getEntityRegistry();
+	this->colliders = colliders;
+	this->columns = ORIGINAL_WIDTH / COLLISION_CELL_SIZE;
+	this->rows = ORIGINAL_HEIGHT / COLLISION_CELL_SIZE;
+	this->reachX = 0;
+	this->reachY = 0;
+
+	this->cellHeads.assign(this->columns * this->rows, -1);
+}
+
+// The list must be complete by now; an entity belongs to at most one grid
+void CollisionGrid::build() {
+	int count = (int)this->colliders->size();
+
+	this->cellHeads.assign(this->columns * this->rows, -1);
+	this->nextInCell.assign(count, -1);
+	this->previousInCell.assign(count, -1);
+	this->cellOf.assign(count, -1);
+	this->foundIndices.reserve(count);
+	this->found.reserve(count);
+	this->reachX = 0;
+	this->reachY = 0;
+
+	for (int i = 0; i < count; i++) {
+		int registryIndex = this->colliders->at(i)->getRegistryIndex();
+
+		this->reachX = std::fmax(this->reachX, this->registry->getExtentX(registryIndex) / 2);
+		this->reachY = std::fmax(this->reachY, this->registry->getExtentY(registryIndex) / 2);
+
+		this->registry->setGrid(registryIndex, this, i);
+		this->link(i, this->cellAt(this->registry->getX(registryIndex), this->registry->getY(registryIndex)));
+	}
+}
+
+void CollisionGrid::refresh(int index) {
+	int registryIndex = this->colliders->at(index)->getRegistryIndex();
+	int cell = this->cellAt(this->registry->getX(registryIndex), this->registry->getY(registryIndex));
+
+	if (cell != this->cellOf[index]) {
+		this->unlink(index);
+		this->link(index, cell);
+	}
+}
+
+const std::vector<Entity*>& CollisionGrid::query(Entity* entity) {
+	int registryIndex = entity->getRegistryIndex();
+
+	return this->query(entity, this->registry->getExtentX(registryIndex), this->registry->getExtentY(registryIndex));
+}
+
+// Everything whose box could overlap a box of the given size centred on the entity, in list order so
+// that callers react to hits in the same order a full scan would
+const std::vector<Entity*>& CollisionGrid::query(Entity* entity, double width, double height) {
+	int registryIndex = entity->getRegistryIndex();
+	double x = this->registry->getX(registryIndex);
+	double y = this->registry->getY(registryIndex);
+	double halfWidth = width / 2 + this->reachX;
+	double halfHeight = height / 2 + this->reachY;
+
+	int firstColumn = this->columnAt(x - halfWidth);
+	int lastColumn = this->columnAt(x + halfWidth);
+	int firstRow = this->rowAt(y - halfHeight);
+	int lastRow = this->rowAt(y + halfHeight);
+
+	this->foundIndices.clear();
+	this->found.clear();
+
+	for (int row = firstRow; row <= lastRow; row++) {
+		for (int column = firstColumn; column <= lastColumn; column++) {
+			for (int i = this->cellHeads[row * this->columns + column]; i >= 0; i = this->nextInCell[i]) {
+				int position = (int)this->foundIndices.size();
+
+				this->foundIndices.push_back(i);
+
+				for (; position > 0 && this->foundIndices[position - 1] > i; position--) {
+					this->foundIndices[position] = this->foundIndices[position - 1];
+				}
+
+				this->foundIndices[position] = i;
+			}
+		}
+	}
+
+	for (int index : this->foundIndices) {
+		this->found.push_back(this->colliders->at(index));
+	}
+
+	return this->found;
+}
+
+// Colliders off the grid are kept in the border cells, which queries reaching past the edge also clamp to
+int CollisionGrid::cellAt(double x, double y) {
+	return this->rowAt(y) * this->columns + this->columnAt(x);
+}
+
+int CollisionGrid::columnAt(double x) {
+	int column = (int)std::floor(x / COLLISION_CELL_SIZE);
+
+	return column < 0 ? 0 : (column >= this->columns ? this->columns - 1 : column);
+}
+
+int CollisionGrid::rowAt(double y) {
+	int row = (int)std::floor(y / COLLISION_CELL_SIZE);
+
+	return row < 0 ? 0 : (row >= this->rows ? this->rows - 1 : row);
+}
+
+void CollisionGrid::link(int index, int cell) {
+	int head = this->cellHeads[cell];
+
+	this->cellOf[index] = cell;
+	this->previousInCell[index] = -1;
+	this->nextInCell[index] = head;
+
+	if (head >= 0) {
+		this->previousInCell[head] = index;
+	}
+
+	this->cellHeads[cell] = index;
+}
+
+void CollisionGrid::unlink(int index) {
+	int previous = this->previousInCell[index];
+	int next = this->nextInCell[index];
+
+	if (previous >= 0) {
+		this->nextInCell[previous] = next;
+	}
+	else {
+		this->cellHeads[this->cellOf[index]] = next;
+	}
+
+	if (next >= 0) {
+		this->previousInCell[next] = previous;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include "ArenaObject.h"
+
+class Engine;
+class Entity;
+class EntityRegistry;
+
+const int COLLISION_CELL_SIZE = 16;
+
+// Uniform grid over one list of colliders, one tile per cell. Each collider sits in the cell under
+// its centre and queries widen by the largest collider, so nothing that could touch is missed. Cells
+// are filled by build() at level load and the registry moves an entry whenever its entity moves
+class CollisionGrid : public ArenaObject {
+	EntityRegistry* registry;
+	std::vector<Entity*>* colliders;
+
+	std::vector<int> cellHeads;
+	std::vector<int> nextInCell;
+	std::vector<int> previousInCell;
+	std::vector<int> cellOf;
+	std::vector<int> foundIndices;
+	std::vector<Entity*> found;
+
+	int columns;
+	int rows;
+	double reachX;
+	double reachY;
+
+public:
+	CollisionGrid(Engine* engine, std::vector<Entity*>* colliders);
+
+	void build();
+	void refresh(int index);
+
+	const std::vector<Entity*>& query(Entity* entity);
+	const std::vector<Entity*>& query(Entity* entity, double width, double height);
+
+private:
+	int cellAt(double x, double y);
+	int columnAt(double x);
+	int rowAt(double y);
+	void link(int index, int cell);
+	void unlink(int index);
+};
@@ -7,5 +7,7 @@ Component::Component(Engine* engine, Entity* entity) {
 
 void Component::init() { }
 void Component::update(double dt) { }
+void Component::animate(double dt) { }
+void Component::render(double alpha) { }
 
 Component::~Component() { }
\ No newline at end of file
@@ -14,6 +14,8 @@ public:
 
 	virtual void init();
 	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 
 	virtual ~Component();
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include <tuple>
+#include <utility>
+#include <typeinfo>
+#include "Profiler.h"
+
+// The components an entity type always has, listed at compile time. Each call names the component's
+// own method, so it is a direct call the compiler can inline instead of a virtual one. Components
+// run in the order they are listed, before any added later through Entity::addComponent
+template <typename... Components>
+class ComponentSet {
+	std::tuple<Components*...> components;
+
+public:
+	ComponentSet() : components() { }
+
+	void set(Components*... components) {
+		this->components = std::tuple<Components*...>(components...);
+	}
+
+	template <size_t Index>
+	typename std::tuple_element<Index, std::tuple<Components*...>>::type get() {
+		return std::get<Index>(this->components);
+	}
+
+	void init() {
+		this->initAll(std::index_sequence_for<Components...>());
+	}
+
+	void update(double dt, Profiler* profiler) {
+		this->updateAll(dt, profiler, std::index_sequence_for<Components...>());
+	}
+
+	void animate(double dt) {
+		this->animateAll(dt, std::index_sequence_for<Components...>());
+	}
+
+	void render(double alpha) {
+		this->renderAll(alpha, std::index_sequence_for<Components...>());
+	}
+
+	~ComponentSet() {
+		this->deleteAll(std::index_sequence_for<Components...>());
+	}
+
+private:
+	// Braced initializers are evaluated left to right, which keeps the listed order
+	template <size_t... Indices>
+	void initAll(std::index_sequence<Indices...>) {
+		int expand[] = { 0, (ComponentSet::initOne(std::get<Indices>(this->components)), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... Indices>
+	void updateAll(double dt, Profiler* profiler, std::index_sequence<Indices...>) {
+		int expand[] = { 0, (ComponentSet::updateOne(std::get<Indices>(this->components), dt, profiler), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... Indices>
+	void animateAll(double dt, std::index_sequence<Indices...>) {
+		int expand[] = { 0, (ComponentSet::animateOne(std::get<Indices>(this->components), dt), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... Indices>
+	void renderAll(double alpha, std::index_sequence<Indices...>) {
+		int expand[] = { 0, (ComponentSet::renderOne(std::get<Indices>(this->components), alpha), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... Indices>
+	void deleteAll(std::index_sequence<Indices...>) {
+		int expand[] = { 0, (delete std::get<Indices>(this->components), 0)... };
+		(void)expand;
+	}
+
+	template <typename T>
+	static void initOne(T* component) {
+		component->T::init();
+	}
+
+	template <typename T>
+	static void updateOne(T* component, double dt, Profiler* profiler) {
+		ProfileScope scope(profiler, typeid(T).name());
+		component->T::update(dt);
+	}
+
+	template <typename T>
+	static void animateOne(T* component, double dt) {
+		component->T::animate(dt);
+	}
+
+	template <typename T>
+	static void renderOne(T* component, double alpha) {
+		component->T::render(alpha);
+	}
+};
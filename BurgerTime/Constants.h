@@ -16,10 +16,14 @@ const int COOK_DIE_ANIMATION_MILLISECS = 200;
 const int COOK_CELEBRATE_ANIMATION_MILLISECS = 300;
 const int PEPPER_ANIMATION_MILLISECS = 100;
 const int INTRO_DURATION_MILLISECS = 4000;
+const int SIMULATION_TICKS_PER_SECOND = 60;
+const int MAX_SIMULATION_TICKS_PER_FRAME = 5;
 const int INITIAL_LIVES = 4;
 const int MAX_LIVES = 25;
 const int INITIAL_PEPPER = 5;
 const int MAX_PEPPER = 99;
+const int INGREDIENT_FLOOR_HIT_SCORE = 50;
+const int ENEMY_SQUASHED_SCORE = 100;
 
 const Uint8 CONTROLLER_UP = 100;
 const Uint8 CONTROLLER_RIGHT = 101;
@@ -27,4 +31,4 @@ const Uint8 CONTROLLER_DOWN = 102;
 const Uint8 CONTROLLER_LEFT = 103;
 
 
-const double ENEMY_PLAYER_SPEED_PROPORTION = 0.6;
\ No newline at end of file
+constexpr double ENEMY_PLAYER_SPEED_PROPORTION = 0.6;
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
+#include "ArenaObject.h"
 
-class Coordinate {
+class Coordinate : public ArenaObject {
 	double x;
 	double y;
 
@@ -3,14 +3,15 @@
 #include "Engine.h"
 
 DishFakeFloorEntity::DishFakeFloorEntity(Engine* engine, Coordinate* position) : Entity(engine, position) {
-	this->setBoundingBox(new BoundingBox(new Coordinate(32, 2)));
+	this->setBoundingBox(32, 2);
 }
 
 void DishFakeFloorEntity::receive(Message message) {
 	if (message == INGREDIENT_ON_FLOOR) {
-		Coordinate* position = this->getPosition();
-		position->setY(position->getY() - 8);
+		Coordinate position = this->getPosition();
+		position.setY(position.getY() - 8);
+		this->setPosition(position);
 
-		this->engine->getMessageDispatcher()->send(INGREDIENT_FINISHED);
+		this->engine->getMessageDispatcher()->post(INGREDIENT_FINISHED, this);
 	}
 }
\ No newline at end of file
@@ -7,5 +7,6 @@ class DishFakeFloorEntity : public Entity {
 public:
 	DishFakeFloorEntity(Engine* engine, Coordinate* position);
 
+	using Receiver::receive;
 	virtual void receive(Message message);
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "DrawList.h"
+#include <algorithm>
+#include <cstring>
+
+DrawList::DrawList() {
+	this->commands = new std::vector<DrawCommand>();
+}
+
+void DrawList::clear() {
+	this->commands->clear();
+}
+
+void DrawList::addTexture(SDL_Texture* texture, SDL_Rect* destination, int layer) {
+	DrawCommand command;
+
+	command.type = DRAW_TEXTURE;
+	command.texture = texture;
+	command.rect = *destination;
+	command.layer = layer;
+	command.font = nullptr;
+
+	this->commands->push_back(command);
+}
+
+void DrawList::addText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale, int layer) {
+	DrawCommand command;
+
+	command.type = DRAW_TEXT;
+	command.texture = nullptr;
+	command.rect = { x, y, 0, 0 };
+	command.layer = layer;
+	command.font = font;
+	command.color = color;
+	command.scale = scale;
+
+	strncpy(command.text, message, DRAW_TEXT_LENGTH - 1);
+	command.text[DRAW_TEXT_LENGTH - 1] = '\0';
+
+	this->commands->push_back(command);
+}
+
+void DrawList::addRect(SDL_Rect* destination, SDL_Color color, int layer) {
+	DrawCommand command;
+
+	command.type = DRAW_RECT;
+	command.texture = nullptr;
+	command.rect = *destination;
+	command.layer = layer;
+	command.font = nullptr;
+	command.color = color;
+
+	this->commands->push_back(command);
+}
+
+void DrawList::sortByLayer() {
+	std::stable_sort(this->commands->begin(), this->commands->end(), [](const DrawCommand& a, const DrawCommand& b) {
+		return a.layer < b.layer;
+	});
+}
+
+std::vector<DrawCommand>* DrawList::getCommands() {
+	return this->commands;
+}
+
+DrawList::~DrawList() {
+	delete this->commands;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "SDL.h"
+#include "SDL_ttf.h"
+
+const int DRAW_LAYER_WORLD = 0;
+const int DRAW_LAYER_HUD = 1;
+const int DRAW_TEXT_LENGTH = 64;
+
+enum DrawCommandType { DRAW_TEXTURE, DRAW_TEXT, DRAW_RECT };
+
+struct DrawCommand {
+	DrawCommandType type;
+	SDL_Texture* texture;
+	SDL_Rect rect;
+	int layer;
+
+	TTF_Font* font;
+	SDL_Color color;
+	int scale;
+	char text[DRAW_TEXT_LENGTH];
+};
+
+class DrawList {
+	std::vector<DrawCommand>* commands;
+
+public:
+	DrawList();
+
+	void clear();
+	void addTexture(SDL_Texture* texture, SDL_Rect* destination, int layer);
+	void addText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale, int layer);
+	void addRect(SDL_Rect* destination, SDL_Color color, int layer);
+	void sortByLayer();
+
+	std::vector<DrawCommand>* getCommands();
+
+	~DrawList();
+};
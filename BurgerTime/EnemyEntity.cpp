@@ -3,49 +3,64 @@
 #include "EnemyRenderComponent.h"
 #include "EnemyIngredientCollideComponent.h"
 #include "WalkingRigidBodyComponent.h"
-#include <cstdlib>
+#include "Engine.h"
 
-EnemyEntity::EnemyEntity(Engine* engine, Coordinate* position, EnemyType enemyType, double idleTime, PlayerEntity* player, std::vector<Entity*>* ingredients) : Entity(engine, position) {
+EnemyEntity::EnemyEntity(Engine* engine, Coordinate* position, EnemyType enemyType, double idleTime, PlayerEntity* player, SweepAndPrune* bodies) : Entity(engine, position) {
 	this->initialPosition = new Coordinate(position->getX(), position->getY());
-	this->action = NO_ACTION;
+	this->setAction(NO_ACTION);
 	this->deadTime = 0;
+	this->squashedTime = 0;
+	this->stunnedTime = 0;
 	this->idleTime = idleTime + INTRO_DURATION_MILLISECS / 1000.0;
 	this->initialIdleTime = idleTime;
 	this->hasMoved = false;
 	this->canMove = true;
 	this->player = player;
 
-	std::vector<Entity*>* pepperVector = new std::vector<Entity*>();
-	pepperVector->push_back(player->getPepper());
-	
-	this->setBoundingBox(new BoundingBox(new Coordinate(16, 16)));
-	this->addComponent(new EnemyRenderComponent(engine, this, enemyType));
-	this->addComponent(new BoxCollideComponent(engine, this, ENEMY_PEPPERED, pepperVector));
-	this->addComponent(new EnemyIngredientCollideComponent(engine, this, ingredients));
-	this->addComponent(new WalkingRigidBodyComponent(this->engine, this, false));
+	this->setBoundingBox(16, 16);
+	this->fixedComponents.set(new EnemyRenderComponent(engine, this, enemyType), new BoxCollideComponent(engine, this, ENEMY_PEPPERED, bodies, BODY_PEPPER),
+		new EnemyIngredientCollideComponent(engine, this, bodies), new WalkingRigidBodyComponent<EnemyEntity>(this->engine, this));
+}
+
+void EnemyEntity::initFixedComponents() {
+	this->fixedComponents.init();
+}
+
+// Timers run ahead of the components, the point in the tick where the render component used to drive them
+void EnemyEntity::updateFixedComponents(double dt, Profiler* profiler) {
+	this->updateTimers(dt);
+	this->fixedComponents.update(dt, profiler);
+}
+
+void EnemyEntity::animateFixedComponents(double dt) {
+	this->fixedComponents.animate(dt);
+}
+
+void EnemyEntity::renderFixedComponents(double alpha) {
+	this->fixedComponents.render(alpha);
 }
 
 void EnemyEntity::update(double dt) {
 	Entity::update(dt);
 
 	if (this->hasReceived(ENEMY_SQUASHED)) {
-		this->action = DIE;
+		this->setAction(DIE);
 		this->canMove = false;
-		this->engine->getMessageDispatcher()->send(ENEMY_SQUASHED);
+		this->engine->getMessageDispatcher()->post(ENEMY_SQUASHED, this, ENEMY_SQUASHED_SCORE);
 	}
-	if (this->hasReceived(ENEMY_PEPPERED) || this->action == STUNNED) {
-		this->action = STUNNED;
+	if (this->hasReceived(ENEMY_PEPPERED) || this->getAction() == STUNNED) {
+		this->setAction(STUNNED);
 		this->canMove = false;
 	}
 	if (this->hasReceived(ENEMY_UNPEPPERED)) {
-		this->action = NO_ACTION;
+		this->setAction(NO_ACTION);
 		this->canMove = true;
 		this->hasMoved = false;
 	}
 	if (this->hasReceived(ENEMY_ATTACK)) {
-		this->engine->getMessageDispatcher()->send(ENEMY_ATTACK);
+		this->engine->getMessageDispatcher()->post(ENEMY_ATTACK, this);
 	}
-	if (this->action == DIE) {
+	if (this->getAction() == DIE) {
 		this->deadTime += dt;
 
 		if (this->deadTime >= 2) {
@@ -59,50 +74,97 @@ void EnemyEntity::update(double dt) {
 
 	this->move();
 
+	if (!this->getEnabled()) {
+		this->sleepUntilRespawn(dt);
+	}
+
 	this->clearMessages();
 }
 
 void EnemyEntity::freeze() {
-	this->action = NO_ACTION;
+	this->setAction(NO_ACTION);
 	this->canMove = false;
 }
 
 void EnemyEntity::respawn() {
+	this->wake();
 	this->setEnabled(true);
 	this->setPosition(*this->initialPosition);
-	this->action = NO_ACTION;
+	this->savePreviousPosition();
+	this->setAction(NO_ACTION);
 	this->deadTime = 0;
 	this->canMove = true;
 	this->hasMoved = false;
 	this->idleTime = this->initialIdleTime;
 }
 
-CharacterAction EnemyEntity::getAction() {
-	return this->action;
+void EnemyEntity::updateTimers(double dt) {
+	switch (this->getAction()) {
+		case STUNNED:
+			this->stunnedTime += dt;
+
+			if (this->stunnedTime * 1000 >= ENEMY_STUNNED_ANIMATION_MILLISECS * 16) {
+				this->stunnedTime = 0;
+				this->receive(ENEMY_UNPEPPERED);
+			}
+			break;
+		case DIE:
+			this->squashedTime += dt;
+
+			// The squashed animation has played out, the enemy stays hidden until it respawns
+			if (this->squashedTime * 1000 >= ENEMY_SQUASHED_ANIMATION_MILLISECS * 4) {
+				this->setEnabled(false);
+				this->squashedTime = 0;
+				this->stunnedTime = 0;
+			}
+			break;
+	}
+}
+
+// Hidden, the enemy only counts down to its respawn, so the count is run ahead and the enemy sleeps
+// until the tick that finishes it. Frozen, it waits for Game to respawn it
+void EnemyEntity::sleepUntilRespawn(double dt) {
+	if (this->getAction() != DIE) {
+		this->sleep();
+		return;
+	}
+
+	int ticks = 0;
+
+	while (this->deadTime + dt < 2) {
+		this->deadTime += dt;
+		ticks++;
+	}
+
+	this->sleepFor(ticks);
 }
 
 void EnemyEntity::move() {
 	if (this->canMove && this->idleTime <= 0) {
-		std::vector<CharacterAction> possibleMoves = std::vector<CharacterAction>();
-		std::vector<int> movesProbabilities = std::vector<int>();
+		CharacterAction possibleMoves[MAX_ENEMY_MOVES];
+		int movesProbabilities[MAX_ENEMY_MOVES];
+		int moveCount = 0;
 		int currentProbability = 0;
 
-		int diffX = (int)this->player->getPosition()->getX() - (int)this->position->getX();
-		int diffY = (int)this->player->getPosition()->getY() - (int)this->position->getY();
+		Coordinate playerPosition = this->player->getPosition();
+		Coordinate position = this->getPosition();
+
+		int diffX = (int)playerPosition.getX() - (int)position.getX();
+		int diffY = (int)playerPosition.getY() - (int)position.getY();
 
 		if (this->isInIntersection() || !this->hasMoved) {
 			if (this->hasReceived(ON_FLOOR)) {
 				if (!this->hasReceived(INTERSECT_LIMIT_LEFT)) {
 					currentProbability += diffX < 0 ? -diffX : 1;
 
-					possibleMoves.push_back(WALK_LEFT);
-					movesProbabilities.push_back(currentProbability);
+					possibleMoves[moveCount] = WALK_LEFT;
+					movesProbabilities[moveCount++] = currentProbability;
 				}
 				if (!this->hasReceived(INTERSECT_LIMIT_RIGHT)) {
 					currentProbability += diffX > 0 ? diffX : 1;
 
-					possibleMoves.push_back(WALK_RIGHT);
-					movesProbabilities.push_back(currentProbability);
+					possibleMoves[moveCount] = WALK_RIGHT;
+					movesProbabilities[moveCount++] = currentProbability;
 				}
 			}
 
@@ -110,29 +172,30 @@ void EnemyEntity::move() {
 				if (!this->hasReceived(INTERSECT_UP_STAIRS)) {
 					currentProbability += diffY < 0 ? -diffY : 1;
 
-					possibleMoves.push_back(GO_UPSTAIRS);
-					movesProbabilities.push_back(currentProbability);
+					possibleMoves[moveCount] = GO_UPSTAIRS;
+					movesProbabilities[moveCount++] = currentProbability;
 				}
 				if (!this->hasReceived(INTERSECT_DOWN_STAIRS)) {
 					currentProbability += diffY > 0 ? diffY : 1;
-					possibleMoves.push_back(GO_DOWNSTAIRS);
 
-					movesProbabilities.push_back(currentProbability);
+					possibleMoves[moveCount] = GO_DOWNSTAIRS;
+					movesProbabilities[moveCount++] = currentProbability;
 				}
 			}
 
-			int random = rand() % currentProbability;
+			int random = this->engine->getRandom()->nextInt(currentProbability);
 			int index = 0;
 
-			for (index = 0; movesProbabilities.at(index) <= random; index++);
+			for (index = 0; index < moveCount - 1 && movesProbabilities[index] <= random; index++);
 
-			this->action = possibleMoves.at(index);
-			this->hasMoved = this->action != NO_ACTION;
+			this->setAction(possibleMoves[index]);
+			this->hasMoved = this->getAction() != NO_ACTION;
 		}
 	}
 }
 
 bool EnemyEntity::isInIntersection() {
-	return this->hasReceived(ON_FLOOR) && 
-		(this->hasReceived(INTERSECT_LIMIT_LEFT) || this->hasReceived(INTERSECT_LIMIT_RIGHT) || this->hasReceived(INTERSECT_STAIRS));
+	return this->hasReceived(ON_FLOOR) && this->hasReceivedAny({ INTERSECT_LIMIT_LEFT, INTERSECT_LIMIT_RIGHT, INTERSECT_STAIRS });
 }
+
+EnemyEntity::~EnemyEntity() { }
@@ -1,16 +1,30 @@
 #pragma once
 #include "Entity.h"
 #include "PlayerEntity.h"
+#include "ComponentSet.h"
+#include "Constants.h"
+#include "SweepAndPrune.h"
 
 class PlayerEntity;
+class EnemyEntity;
+class EnemyRenderComponent;
+class BoxCollideComponent;
+class EnemyIngredientCollideComponent;
+template <typename Owner> class WalkingRigidBodyComponent;
 enum EnemyType { SAUSAGE, EGG, CUCUMBER };
 
+typedef ComponentSet<EnemyRenderComponent, BoxCollideComponent, EnemyIngredientCollideComponent, WalkingRigidBodyComponent<EnemyEntity>> EnemyComponents;
+
+const int MAX_ENEMY_MOVES = 4;
+
 class EnemyEntity : public Entity {
+	EnemyComponents fixedComponents;
 	Coordinate* initialPosition;
-	CharacterAction action;
 	PlayerEntity* player;
 
 	double deadTime;
+	double squashedTime;
+	double stunnedTime;
 	double idleTime;
 	double initialIdleTime;
 
@@ -18,16 +32,26 @@ class EnemyEntity : public Entity {
 	bool canMove;
 
 public:
-	EnemyEntity(Engine* engine, Coordinate* position, EnemyType enemyType, double idleTime, PlayerEntity* player, std::vector<Entity*>* ingredients);
+	static constexpr double WALKING_SPEED_PROPORTION = ENEMY_PLAYER_SPEED_PROPORTION;
+
+	EnemyEntity(Engine* engine, Coordinate* position, EnemyType enemyType, double idleTime, PlayerEntity* player, SweepAndPrune* bodies);
 
 	virtual void update(double dt);
 
 	void freeze();
 	void respawn();
-	
-	CharacterAction getAction();
+
+	~EnemyEntity();
+
+protected:
+	virtual void initFixedComponents();
+	virtual void updateFixedComponents(double dt, Profiler* profiler);
+	virtual void animateFixedComponents(double dt);
+	virtual void renderFixedComponents(double alpha);
 
 private:
+	void updateTimers(double dt);
+	void sleepUntilRespawn(double dt);
 	void move();
 	bool isInIntersection();
 };
@@ -1,18 +1,14 @@
 #include "EnemyIngredientCollideComponent.h"
 #include "IngredientEntity.h"
 
-EnemyIngredientCollideComponent::EnemyIngredientCollideComponent(Engine* engine, Entity* enemy, std::vector<Entity*>* ingredients) : Component(engine, enemy) {
-	this->ingredients = ingredients;
+EnemyIngredientCollideComponent::EnemyIngredientCollideComponent(Engine* engine, Entity* enemy, SweepAndPrune* bodies) : Component(engine, enemy) {
+	this->bodies = bodies;
 }
 
 void EnemyIngredientCollideComponent::update(double dt) {
-	for (Entity* ingredient : *this->ingredients) {
-		BoundingBox* enemyBox = this->entity->getBoundingBox();
-		BoundingBox* ingredientBox = ingredient->getBoundingBox();
-
-		bool intersect = enemyBox->isIntersecting(this->entity->getPosition(), ingredient->getPosition(), ingredientBox);
-
-		if (intersect && ((IngredientEntity*) ingredient)->isFalling()) {
+	for (Entity* ingredient : this->bodies->query(this->entity, BODY_INGREDIENTS)) {
+		// Only a falling ingredient squashes, so resting ones are not tested at all
+		if (((IngredientEntity*) ingredient)->isFalling() && this->entity->isIntersecting(ingredient)) {
 			this->entity->receive(ENEMY_SQUASHED);
 		}
 	}
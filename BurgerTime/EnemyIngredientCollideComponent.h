@@ -1,10 +1,12 @@
 #pragma once
 #include "Component.h"
+#include "SweepAndPrune.h"
+
 class EnemyIngredientCollideComponent : public Component {
-	std::vector<Entity*>* ingredients;
+	SweepAndPrune* bodies;
 
 public:
-	EnemyIngredientCollideComponent(Engine* engine, Entity* enemy, std::vector<Entity*>* ingredients);
+	EnemyIngredientCollideComponent(Engine* engine, Entity* enemy, SweepAndPrune* bodies);
 
 	virtual void update(double dt);
 };
@@ -1,26 +1,23 @@
 #include "EnemyPlayerCollideComponent.h"
 #include "EnemyEntity.h"
+#include "Engine.h"
 
-EnemyPlayerCollideComponent::EnemyPlayerCollideComponent(Engine* engine, Entity* entity, std::vector<Entity*>* enemies) : Component(engine, entity) {
-	this->enemies = enemies;
+EnemyPlayerCollideComponent::EnemyPlayerCollideComponent(Engine* engine, Entity* entity, SweepAndPrune* bodies) : Component(engine, entity) {
+	this->bodies = bodies;
 }
 
 void EnemyPlayerCollideComponent::update(double dt) {
-	for (Entity* collider: *this->enemies) {
-		if (this->entity != collider) {
+	for (Entity* collider : this->bodies->query(this->entity, BODY_ENEMIES)) {
+		if (this->entity != collider && collider->getEnabled()) {
 			EnemyEntity* enemy = (EnemyEntity*)collider;
 
-			BoundingBox* thisBox = this->entity->getBoundingBox();
-			BoundingBox* otherBox = new BoundingBox(new Coordinate(2,2));
-
-			if (thisBox->isIntersecting(this->entity->getPosition(), enemy->getPosition(), otherBox)) {
+			// Only the centre of the enemy counts as a hit
+			if (enemy->isIntersecting(this->entity, 2, 2)) {
 				if (enemy->getAction() != DIE && enemy->getAction() != STUNNED) {
 					this->entity->receive(ENEMY_ATTACK);
-					enemy->receive(ENEMY_ATTACK);
+					this->engine->getMessageDispatcher()->sendTo(enemy, ENEMY_ATTACK);
 				}
 			}
-
-			delete otherBox;
 		}
 	}
 }
\ No newline at end of file
@@ -1,11 +1,12 @@
 #pragma once
 #include "Component.h"
+#include "SweepAndPrune.h"
 
 class EnemyPlayerCollideComponent : public Component {
-	std::vector<Entity*>* enemies;
+	SweepAndPrune* bodies;
 
 public:
-	EnemyPlayerCollideComponent(Engine* engine, Entity* entity, std::vector<Entity*>* enemies);
+	EnemyPlayerCollideComponent(Engine* engine, Entity* entity, SweepAndPrune* bodies);
 
 	virtual void update(double dt);
 };
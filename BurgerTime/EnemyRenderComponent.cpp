@@ -5,8 +5,6 @@
 EnemyRenderComponent::EnemyRenderComponent(Engine* engine, Entity* entity, EnemyType enemyType) : Component(engine, entity) {
 	char enemyPattern[200];
 
-	this->deadTime = this->stunnedTime = 0;
-
 	this->writeSpritePattern(enemyPattern, "resources/sprites/%s_left (%%d).bmp", enemyType);
 	this->walkingLeft = new Sprite(engine->getRenderer(), enemyPattern, 1, 2, ENEMY_WALKING_ANIMATION_MILLISECS);
 	
@@ -27,12 +25,13 @@ EnemyRenderComponent::EnemyRenderComponent(Engine* engine, Entity* entity, Enemy
 
 	this->writeSpritePattern(enemyPattern, "resources/sprites/%s_downstairs (1).bmp", enemyType);
 	this->standStill = new Sprite(engine->getRenderer(), enemyPattern);
+	this->currentSprite = this->standStill;
 }
 
-void EnemyRenderComponent::update(double dt) {
+void EnemyRenderComponent::animate(double dt) {
 	Sprite* sprite = nullptr;
 	
-	switch (((EnemyEntity*)this->entity)->getAction()) {
+	switch (this->entity->getAction()) {
 		case WALK_LEFT:
 			sprite = this->walkingLeft;
 			break;
@@ -47,29 +46,23 @@ void EnemyRenderComponent::update(double dt) {
 			break;
 		case STUNNED:
 			sprite = this->stunned;
-			this->stunnedTime += dt;
-
-			if (this->stunnedTime * 1000 >= ENEMY_STUNNED_ANIMATION_MILLISECS * 16) {
-				this->stunnedTime = 0;
-				this->entity->receive(ENEMY_UNPEPPERED);
-			}
 			break;
 		case DIE:
 			sprite = this->squashed;
-			this->deadTime += dt;
-
-			if (this->deadTime * 1000 >= ENEMY_SQUASHED_ANIMATION_MILLISECS * 4) {
-				this->entity->setEnabled(false);
-				this->deadTime = 0;
-				this->stunnedTime = 0;
-			}
 			break;
 		default:
 			sprite = this->standStill;
 			break;
 	}
 
-	sprite->draw((int)this->entity->getPosition()->getX(), (int)this->entity->getPosition()->getY(), dt);
+	sprite->update(dt);
+	this->currentSprite = sprite;
+}
+
+void EnemyRenderComponent::render(double alpha) {
+	Coordinate position = this->entity->getInterpolatedPosition(alpha);
+
+	this->currentSprite->draw((int)position.getX(), (int)position.getY());
 }
 
 void EnemyRenderComponent::writeSpritePattern(char* buffer, const char* prePattern, EnemyType enemyType) {
@@ -11,14 +11,13 @@ class EnemyRenderComponent : public Component {
 	Sprite* squashed;
 	Sprite* stunned;
 	Sprite* standStill;
-
-	double deadTime;
-	double stunnedTime;
+	Sprite* currentSprite;
 
 public:
 	EnemyRenderComponent(Engine* engine, Entity* entity, EnemyType enemyType);
 
-	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 
 	~EnemyRenderComponent();
 
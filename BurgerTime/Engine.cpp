@@ -2,8 +2,36 @@
 #include "SDL_ttf.h"
 #include "SDL_mixer.h"
 #include "Constants.h"
-#include <chrono>
-#include <thread>
+#include "SdlRenderBackend.h"
+#include "SdlAudioBackend.h"
+#include "NullRenderBackend.h"
+#include "NullAudioBackend.h"
+#include "PerformanceCounters.h"
+#include <cmath>
+
+Engine::Engine() {
+	this->game = nullptr;
+	this->renderer = nullptr;
+	this->audio = nullptr;
+	this->joystick = nullptr;
+	this->messageDispatcher = nullptr;
+	this->framePacer = nullptr;
+	this->random = new Random(1);
+	this->profiler = new Profiler();
+	this->entityRegistry = new EntityRegistry();
+	this->activeEntities = new ActiveEntitySet();
+	this->recording = nullptr;
+	this->replay = nullptr;
+	this->recordingPath = nullptr;
+	this->pendingInput = new std::vector<InputEvent>();
+	this->inputLatency = 0;
+	this->headless = false;
+	this->renderWhenHeadless = false;
+	this->overlayVisible = false;
+	this->frameStats = { 0, 0, 0, 0, 0 };
+	this->seed = 1;
+	this->currentTick = 0;
+}
 
 bool Engine::init(Game* game, int width, int height) {
 	if (SDL_Init(SDL_INIT_EVERYTHING) != 0 || TTF_Init() != 0 || Mix_OpenAudio(22050, MIX_DEFAULT_FORMAT, 2, 4096) != 0) {
@@ -12,34 +40,114 @@ bool Engine::init(Game* game, int width, int height) {
 	
 	SDL_JoystickEventState(SDL_ENABLE);
 
-	this->window = SDL_CreateWindow("BurgerTime", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, 0);
-	this->renderer = SDL_CreateRenderer(this->window, -1, 0);
+	return this->init(game, new SdlRenderBackend("BurgerTime", width, height), new SdlAudioBackend(), false);
+}
+
+bool Engine::initHeadless(Game* game) {
+	return this->init(game, new NullRenderBackend(), new NullAudioBackend(), true);
+}
+
+bool Engine::init(Game* game, RenderBackend* renderer, AudioBackend* audio, bool headless) {
+	this->renderer = renderer;
+	this->audio = audio;
+	this->headless = headless;
+	this->framePacer = new FramePacer();
 
-	this->millisecondsPerFrame = 0;
-	this->previousFrameEndTime = 0;
-	this->previousUpdateTime = 0;
 	this->keepRendering = true;
+	this->accumulator = 0;
 	this->game = game;
 	this->messageDispatcher = new MessageDispatcher();
 
+	this->setTickRate(SIMULATION_TICKS_PER_SECOND);
+	this->setMaxTicksPerFrame(MAX_SIMULATION_TICKS_PER_FRAME);
+
+	if (this->replay != nullptr) {
+		const char* levelPath = this->replay->popLevel();
+
+		if (levelPath != nullptr) {
+			this->game->setLevelPath(levelPath);
+		}
+
+		this->setTickRate(this->replay->getTicksPerSecond());
+	}
+
+	if (this->recordingPath != nullptr) {
+		this->recording = new InputRecording(this->seed, this->ticksPerSecond);
+		this->recording->addLevel(this->game->getLevelPath());
+	}
+
 	this->game->init();
 
+	this->previousUpdateCounter = SDL_GetPerformanceCounter();
+
 	return true;
 }
 
 bool Engine::update() {
-	int current = this->getElapsedTime();
-	int delta = current - this->previousUpdateTime;
-	this->previousUpdateTime = current;
+	this->profiler->beginFrame();
+
+	ProfileScope frameScope(this->profiler, "Engine::update");
+
+	if (this->headless) {
+		this->runTick();
+
+		if (this->renderWhenHeadless) {
+			ProfileScope scope(this->profiler, "Game::render");
+
+			this->renderer->clear();
+			this->game->render(1.0);
+			this->renderer->present();
+		}
+
+		return this->keepRendering;
+	}
+
+	long allocations = PerformanceCounters::allocations;
+	long collisionTests = PerformanceCounters::collisionTests;
+
+	Uint64 current = SDL_GetPerformanceCounter();
+	double delta = (double)(current - this->previousUpdateCounter) / SDL_GetPerformanceFrequency();
+	this->previousUpdateCounter = current;
+
+	this->accumulator += delta;
+	int ticks = 0;
+
+	while (this->accumulator >= this->secondsPerTick && ticks < this->maxTicksPerFrame && this->keepRendering) {
+		// Sample input right before every tick so catch-up ticks see the latest state
+		this->handleEvents();
+		this->runTick();
+		this->accumulator -= this->secondsPerTick;
+		ticks++;
+	}
+
+	if (ticks == 0) {
+		this->handleEvents();
+	}
+
+	// Too far behind to catch up: drop the backlog instead of spiralling
+	if (this->accumulator >= this->secondsPerTick) {
+		this->accumulator = fmod(this->accumulator, this->secondsPerTick);
+	}
 
-	this->handleEvents();
+	Uint64 simulationEnd = SDL_GetPerformanceCounter();
 
-	SDL_RenderClear(this->renderer);
+	{
+		ProfileScope scope(this->profiler, "Game::render");
 
-	this->game->update(delta / 1000.0);
+		this->renderer->clear();
+		this->game->render(this->accumulator / this->secondsPerTick);
+	}
+	{
+		ProfileScope scope(this->profiler, "RenderBackend::present");
+		this->renderer->present();
+	}
 
-	SDL_RenderPresent(this->renderer);
-	this->fpsLimitSleep();
+	this->finishFrameStats(current, simulationEnd, allocations, collisionTests);
+
+	{
+		ProfileScope scope(this->profiler, "FramePacer::waitForNextFrame");
+		this->framePacer->waitForNextFrame();
+	}
 
 	return this->keepRendering;
 }
@@ -49,7 +157,20 @@ void Engine::stop() {
 }
 
 void Engine::setFpsLimit(int limit) {
-	this->millisecondsPerFrame = 1000 / limit;
+	this->framePacer->setTargetFrameRate(limit);
+}
+
+void Engine::setTickRate(int ticksPerSecond) {
+	this->ticksPerSecond = ticksPerSecond;
+	this->secondsPerTick = 1.0 / ticksPerSecond;
+}
+
+double Engine::getSecondsPerTick() {
+	return this->secondsPerTick;
+}
+
+void Engine::setMaxTicksPerFrame(int maxTicks) {
+	this->maxTicksPerFrame = maxTicks;
 }
 
 int Engine::getElapsedTime() {
@@ -57,77 +178,281 @@ int Engine::getElapsedTime() {
 }
 
 int Engine::getFrameRate() {
-	return this->frameRate;
+	return (int)(this->framePacer->getSmoothedFrameRate() + 0.5);
+}
+
+FramePacer* Engine::getFramePacer() {
+	return this->framePacer;
+}
+
+Profiler* Engine::getProfiler() {
+	return this->profiler;
+}
+
+EntityRegistry* Engine::getEntityRegistry() {
+	return this->entityRegistry;
+}
+
+ActiveEntitySet* Engine::getActiveEntities() {
+	return this->activeEntities;
+}
+
+FrameStats* Engine::getFrameStats() {
+	return &this->frameStats;
+}
+
+bool Engine::isOverlayVisible() {
+	return this->overlayVisible;
+}
+
+void Engine::setOverlayVisible(bool visible) {
+	this->overlayVisible = visible;
 }
 
 bool Engine::getKeyStatus(SDL_Keycode key) {
 	auto found = this->keyStatus.find(key);
 
-	if (found != this->keyStatus.end()) {
-		return found->second;
+	if (found != this->keyStatus.end() && found->second) {
+		return true;
 	}
 
-	return false;
+	found = this->keyLatched.find(key);
+
+	return found != this->keyLatched.end() && found->second;
 }
 
 bool Engine::getControllerStatus(Uint8 button) {
 	auto found = this->controllerStatus.find(button);
 
-	if (found != this->controllerStatus.end()) {
-		return found->second;
+	if (found != this->controllerStatus.end() && found->second) {
+		return true;
 	}
 
-	return false;
+	found = this->controllerLatched.find(button);
+
+	return found != this->controllerLatched.end() && found->second;
 }
 
-SDL_Renderer* Engine::getRenderer() {
+Uint32 Engine::getInputLatency() {
+	return this->inputLatency;
+}
+
+RenderBackend* Engine::getRenderer() {
 	return this->renderer;
 }
 
+AudioBackend* Engine::getAudio() {
+	return this->audio;
+}
+
+bool Engine::isHeadless() {
+	return this->headless;
+}
+
 MessageDispatcher * Engine::getMessageDispatcher() {
 	return this->messageDispatcher;
 }
 
+Random* Engine::getRandom() {
+	return this->random;
+}
+
+void Engine::setSeed(Uint64 seed) {
+	this->seed = seed;
+	this->random->setSeed(seed);
+}
+
+Uint32 Engine::getCurrentTick() {
+	return this->currentTick;
+}
+
+void Engine::startRecording(const char* path) {
+	delete this->recordingPath;
+
+	this->recordingPath = new std::string(path);
+}
+
+bool Engine::startReplay(const char* path) {
+	InputRecording* loaded = InputRecording::load(path);
+
+	if (loaded == nullptr) {
+		return false;
+	}
+
+	this->startReplay(loaded);
+
+	return true;
+}
+
+void Engine::startReplay(InputRecording* recording) {
+	delete this->replay;
+
+	this->replay = recording;
+	this->setSeed(recording->getSeed());
+}
+
+void Engine::setRenderWhenHeadless(bool render) {
+	this->renderWhenHeadless = render;
+}
+
+bool Engine::isReplaying() {
+	return this->replay != nullptr;
+}
+
+const char* Engine::popReplayLevel() {
+	return this->replay != nullptr ? this->replay->popLevel() : nullptr;
+}
+
+void Engine::recordLevel(const char* levelPath) {
+	if (this->recording != nullptr) {
+		this->recording->addLevel(levelPath);
+	}
+}
+
+void Engine::runTick() {
+	ProfileScope scope(this->profiler, "Engine::runTick");
+	InputEvent event;
+
+	for (InputEvent& pending : *this->pendingInput) {
+		pending.tick = this->currentTick;
+		this->applyInputEvent(pending);
+	}
+
+	this->pendingInput->clear();
+
+	if (this->replay != nullptr) {
+		while (this->replay->popEvent(this->currentTick, &event)) {
+			this->applyInputEvent(event);
+		}
+	}
+
+	this->messageDispatcher->drainQueued();
+	this->game->update(this->secondsPerTick);
+	this->currentTick++;
+
+	// Animation is stepped every tick, so catch-up ticks keep sprites in time, but not at all when
+	// no frame will ever be drawn
+	if (!this->headless || this->renderWhenHeadless) {
+		ProfileScope animateScope(this->profiler, "Game::animate");
+		this->game->animate(this->secondsPerTick);
+	}
+
+	// Taps released within a single tick have now been seen once. Entries are kept so a
+	// key pressed again later does not allocate a new map node
+	for (auto& latched : this->keyLatched) {
+		latched.second = false;
+	}
+
+	for (auto& latched : this->controllerLatched) {
+		latched.second = false;
+	}
+
+	if (this->replay != nullptr && this->currentTick >= this->replay->getLength()) {
+		this->stop();
+	}
+}
+
+void Engine::toggleProfiler() {
+	// First press starts capturing, later presses dump the captured frames
+	if (!this->profiler->isEnabled()) {
+		this->profiler->setEnabled(true);
+	}
+	else if (!this->profiler->dump()) {
+		SDL_Log("Could not write profile");
+	}
+}
+
+void Engine::finishFrameStats(Uint64 frameStart, Uint64 simulationEnd, long allocations, long collisionTests) {
+	double frequency = (double)SDL_GetPerformanceFrequency();
+
+	this->frameStats.simulationTime = (simulationEnd - frameStart) / frequency;
+	this->frameStats.renderTime = (SDL_GetPerformanceCounter() - simulationEnd) / frequency;
+	this->frameStats.drawCalls = this->renderer->getDrawCalls();
+	this->frameStats.collisionTests = PerformanceCounters::collisionTests - collisionTests;
+	this->frameStats.allocations = PerformanceCounters::allocations - allocations;
+}
+
+void Engine::queueInputEvent(InputEventType type, Sint32 code, Uint32 timestamp) {
+	this->pendingInput->push_back({ 0, type, code, timestamp });
+}
+
+void Engine::applyInputEvent(InputEvent event) {
+	if (this->recording != nullptr) {
+		this->recording->addEvent(event);
+	}
+
+	if (event.timestamp != 0) {
+		this->inputLatency = SDL_GetTicks() - event.timestamp;
+	}
+
+	switch (event.type) {
+		case INPUT_KEY_DOWN:
+			this->keyStatus[event.code] = true;
+			this->keyLatched[event.code] = true;
+			this->game->notifyKeyDown(event.code);
+			break;
+		case INPUT_KEY_UP:
+			this->keyStatus[event.code] = false;
+			this->game->notifyKeyUp(event.code);
+			break;
+		case INPUT_CONTROLLER_DOWN:
+			this->controllerStatus[(Uint8)event.code] = true;
+			this->controllerLatched[(Uint8)event.code] = true;
+			this->game->notifyControllerDown((Uint8)event.code);
+			break;
+		case INPUT_CONTROLLER_UP:
+			this->controllerStatus[(Uint8)event.code] = false;
+			this->game->notifyControllerUp((Uint8)event.code);
+			break;
+		case INPUT_CONTROLLER_HAT:
+			this->controllerStatus[CONTROLLER_UP] = (event.code & SDL_HAT_UP) != 0;
+			this->controllerStatus[CONTROLLER_RIGHT] = (event.code & SDL_HAT_RIGHT) != 0;
+			this->controllerStatus[CONTROLLER_DOWN] = (event.code & SDL_HAT_DOWN) != 0;
+			this->controllerStatus[CONTROLLER_LEFT] = (event.code & SDL_HAT_LEFT) != 0;
+			break;
+	}
+}
+
 void Engine::handleEvents() {
+	ProfileScope scope(this->profiler, "Engine::handleEvents");
 	SDL_Event event;
 
-	if (SDL_PollEvent(&event)) {
+	while (SDL_PollEvent(&event)) {
+		// Replays own the input stream, live devices only get to quit
+		bool liveInput = this->replay == nullptr;
+
 		switch (event.type) {
 			case SDL_KEYDOWN:
-				this->keyStatus[event.key.keysym.sym] = true;
-				this->game->notifyKeyDown(event.key.keysym.sym);
+				if (event.key.keysym.sym == SDLK_F2 && event.key.repeat == 0) {
+					this->toggleProfiler();
+				}
+				else if (event.key.keysym.sym == SDLK_F3 && event.key.repeat == 0) {
+					this->overlayVisible = !this->overlayVisible;
+				}
+				else if (liveInput && event.key.repeat == 0) {
+					this->queueInputEvent(INPUT_KEY_DOWN, event.key.keysym.sym, event.key.timestamp);
+				}
 				break;
 			case SDL_KEYUP:
-				this->keyStatus[event.key.keysym.sym] = false;
-				this->game->notifyKeyUp(event.key.keysym.sym);
+				if (liveInput) {
+					this->queueInputEvent(INPUT_KEY_UP, event.key.keysym.sym, event.key.timestamp);
+				}
 				break;
 			case SDL_JOYBUTTONDOWN:
-				this->controllerStatus[event.jbutton.button] = true;
-				this->game->notifyControllerDown(event.jbutton.button);
+				if (liveInput) {
+					this->queueInputEvent(INPUT_CONTROLLER_DOWN, event.jbutton.button, event.jbutton.timestamp);
+				}
 				break;
 			case SDL_JOYBUTTONUP:
-				this->controllerStatus[event.jbutton.button] = false;
-				this->game->notifyControllerUp(event.jbutton.button);
+				if (liveInput) {
+					this->queueInputEvent(INPUT_CONTROLLER_UP, event.jbutton.button, event.jbutton.timestamp);
+				}
 
 				SDL_Log("%d", event.jbutton.button);
 				break;
 			case SDL_JOYHATMOTION:
-				this->controllerStatus[CONTROLLER_UP] = false;
-				this->controllerStatus[CONTROLLER_RIGHT] = false;
-				this->controllerStatus[CONTROLLER_DOWN] = false;
-				this->controllerStatus[CONTROLLER_LEFT] = false;
-
-				if (event.jhat.value & SDL_HAT_UP) {
-					this->controllerStatus[CONTROLLER_UP] = true;
-				}
-				if (event.jhat.value & SDL_HAT_RIGHT) {
-					this->controllerStatus[CONTROLLER_RIGHT] = true;
-				}
-				if (event.jhat.value & SDL_HAT_DOWN) {
-					this->controllerStatus[CONTROLLER_DOWN] = true;
-				}
-				if (event.jhat.value & SDL_HAT_LEFT) {
-					this->controllerStatus[CONTROLLER_LEFT] = true;
+				if (liveInput) {
+					this->queueInputEvent(INPUT_CONTROLLER_HAT, event.jhat.value, event.jhat.timestamp);
 				}
 				break;
 			case SDL_CONTROLLERDEVICEADDED:
@@ -143,25 +468,36 @@ void Engine::handleEvents() {
 	}
 }
 
-void Engine::fpsLimitSleep() {
-	int sleepTime = this->millisecondsPerFrame - getElapsedTime() + this->previousFrameEndTime;
-
-	if (sleepTime > 0) {
-		std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
+Engine::~Engine() {
+	if (this->profiler->isEnabled()) {
+		this->profiler->dump();
 	}
 
-	int delta = getElapsedTime() - this->previousFrameEndTime;
-	this->frameRate = delta != 0 ? 1000 / delta : 1000;
-
-	this->previousFrameEndTime = getElapsedTime();
-}
+	if (this->recording != nullptr) {
+		this->recording->setLength(this->currentTick);
 
-Engine::~Engine() {
-	SDL_DestroyRenderer(this->renderer);
-	SDL_DestroyWindow(this->window);
-	SDL_JoystickClose(this->joystick);
+		if (!this->recording->save(this->recordingPath->c_str())) {
+			SDL_Log("Could not write input recording %s", this->recordingPath->c_str());
+		}
+	}
 
-	Mix_CloseAudio();
-	TTF_Quit();
-	SDL_Quit();
+	delete this->recording;
+	delete this->replay;
+	delete this->recordingPath;
+	delete this->pendingInput;
+	delete this->renderer;
+	delete this->audio;
+	delete this->framePacer;
+	delete this->random;
+	delete this->profiler;
+	delete this->entityRegistry;
+	delete this->activeEntities;
+
+	if (!this->headless) {
+		SDL_JoystickClose(this->joystick);
+
+		Mix_CloseAudio();
+		TTF_Quit();
+		SDL_Quit();
+	}
 }
\ No newline at end of file
@@ -5,40 +5,108 @@
 #include "Receiver.h"
 #include "Entity.h"
 #include "Game.h"
+#include "FramePacer.h"
+#include "RenderBackend.h"
+#include "AudioBackend.h"
+#include "Random.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+#include "EntityRegistry.h"
+#include "ActiveEntitySet.h"
 
 class Game;
 
+struct FrameStats {
+	double simulationTime;
+	double renderTime;
+	int drawCalls;
+	long collisionTests;
+	long allocations;
+};
+
 class Engine {
 	Game* game;
-	SDL_Window* window;
-	SDL_Renderer* renderer;
+	RenderBackend* renderer;
+	AudioBackend* audio;
 	SDL_Joystick* joystick;
 	MessageDispatcher* messageDispatcher;
+	FramePacer* framePacer;
+	Profiler* profiler;
+	EntityRegistry* entityRegistry;
+	ActiveEntitySet* activeEntities;
+	Random* random;
+	InputRecording* recording;
+	InputRecording* replay;
+	std::string* recordingPath;
 	std::map<SDL_Keycode, bool> keyStatus;
 	std::map<Uint8, bool> controllerStatus;
+	std::map<SDL_Keycode, bool> keyLatched;
+	std::map<Uint8, bool> controllerLatched;
+	std::vector<InputEvent>* pendingInput;
+	Uint32 inputLatency;
 
-	int millisecondsPerFrame;
-	int previousFrameEndTime;
-	int previousUpdateTime;
-	int frameRate;
 	bool keepRendering;
+	bool headless;
+	bool renderWhenHeadless;
+	bool overlayVisible;
+	FrameStats frameStats;
+
+	Uint64 seed;
+	Uint32 currentTick;
+	int ticksPerSecond;
+	Uint64 previousUpdateCounter;
+	double secondsPerTick;
+	double accumulator;
+	int maxTicksPerFrame;
 
 public:
+	Engine();
+
 	bool init(Game* game, int width, int height);
+	bool initHeadless(Game* game);
+	bool init(Game* game, RenderBackend* renderer, AudioBackend* audio, bool headless);
 
 	bool update();
 	void stop();
 	void setFpsLimit(int limit);
+	void setTickRate(int ticksPerSecond);
+	double getSecondsPerTick();
+	void setMaxTicksPerFrame(int maxTicks);
 	int getElapsedTime();
 	int getFrameRate();
+	FramePacer* getFramePacer();
+	Profiler* getProfiler();
+	EntityRegistry* getEntityRegistry();
+	ActiveEntitySet* getActiveEntities();
+	FrameStats* getFrameStats();
+	bool isOverlayVisible();
+	void setOverlayVisible(bool visible);
 	bool getKeyStatus(SDL_Keycode key);
 	bool getControllerStatus(Uint8 button);
-	SDL_Renderer* getRenderer();
+	Uint32 getInputLatency();
+	RenderBackend* getRenderer();
+	AudioBackend* getAudio();
+	bool isHeadless();
 	MessageDispatcher* getMessageDispatcher();
+	Random* getRandom();
+	void setSeed(Uint64 seed);
+	Uint32 getCurrentTick();
+
+	void startRecording(const char* path);
+	bool startReplay(const char* path);
+	void startReplay(InputRecording* recording);
+	void setRenderWhenHeadless(bool render);
+	bool isReplaying();
+	const char* popReplayLevel();
+	void recordLevel(const char* levelPath);
 
 	~Engine();
 
 private:
 	void handleEvents();
-	void fpsLimitSleep();
+	void runTick();
+	void toggleProfiler();
+	void finishFrameStats(Uint64 frameStart, Uint64 simulationEnd, long allocations, long collisionTests);
+	void queueInputEvent(InputEventType type, Sint32 code, Uint32 timestamp);
+	void applyInputEvent(InputEvent event);
 };
\ No newline at end of file
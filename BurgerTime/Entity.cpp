@@ -1,29 +1,63 @@
 #include "Entity.h"
+#include "Engine.h"
+#include "EntityRegistry.h"
+#include <typeinfo>
 
-Entity::Entity(Engine* engine, Coordinate* position) {
+// The position is copied into the registry, callers keep ownership of what they pass
+Entity::Entity(Engine* engine, Coordinate position) {
 	this->engine = engine;
-	this->position = position;
+	this->registry = engine->getEntityRegistry();
+	this->registryIndex = this->registry->add(this, position.getX(), position.getY());
+	this->activeOrder = -1;
 	this->components = new std::vector<Component*>();
-	this->boundingBox = nullptr;
-	this->enabled = true;
 }
 
-Entity::Entity(Engine* engine) : Entity(engine, new Coordinate(0, 0)) {}
+Entity::Entity(Engine* engine, Coordinate* position) : Entity(engine, *position) {}
+
+Entity::Entity(Engine* engine) : Entity(engine, Coordinate(0, 0)) {}
 
 void Entity::init() {
+	this->initFixedComponents();
+
 	for (auto it = this->components->begin(); it != this->components->end(); it++) {
 		(*it)->init();
 	}
 }
 
 void Entity::update(double dt) {
-	if (this->enabled) {
+	if (this->getEnabled()) {
+		Profiler* profiler = this->engine->getProfiler();
+
+		this->updateFixedComponents(dt, profiler);
+
 		for (auto it = this->components->begin(); it != this->components->end(); it++) {
+			ProfileScope scope(profiler, typeid(**it).name());
 			(*it)->update(dt);
 		}
 	}
 }
 
+// Only visual state moves here, so skipping it when nothing is drawn leaves the game unchanged
+void Entity::animate(double dt) {
+	if (this->getEnabled()) {
+		this->animateFixedComponents(dt);
+
+		for (auto it = this->components->begin(); it != this->components->end(); it++) {
+			(*it)->animate(dt);
+		}
+	}
+}
+
+void Entity::render(double alpha) {
+	if (this->getEnabled()) {
+		this->renderFixedComponents(alpha);
+
+		for (auto it = this->components->begin(); it != this->components->end(); it++) {
+			(*it)->render(alpha);
+		}
+	}
+}
+
 void Entity::addComponent(Component* component) {
 	this->components->push_back(component);
 }
@@ -32,35 +66,110 @@ Component * Entity::getComponent(int index) {
 	return this->components->at(index);
 }
 
-Coordinate* Entity::getPosition() {
-	return this->position;
+Coordinate Entity::getPosition() {
+	return Coordinate(this->registry->getX(this->registryIndex), this->registry->getY(this->registryIndex));
 }
 
 void Entity::setPosition(Coordinate& position) {
-	this->position->copyFrom(position);
+	this->registry->setPosition(this->registryIndex, position.getX(), position.getY());
+}
+
+void Entity::savePreviousPosition() {
+	this->registry->savePreviousPosition(this->registryIndex);
+}
+
+Coordinate Entity::getInterpolatedPosition(double alpha) {
+	Coordinate previous = Coordinate(this->registry->getPreviousX(this->registryIndex), this->registry->getPreviousY(this->registryIndex));
+
+	return previous + (this->getPosition() - previous) * alpha;
+}
+
+Coordinate Entity::getVelocity() {
+	return Coordinate(this->registry->getVelocityX(this->registryIndex), this->registry->getVelocityY(this->registryIndex));
+}
+
+void Entity::setVelocity(double x, double y) {
+	this->registry->setVelocity(this->registryIndex, x, y);
+}
+
+Coordinate Entity::getBoundingBox() {
+	return Coordinate(this->registry->getExtentX(this->registryIndex), this->registry->getExtentY(this->registryIndex));
+}
+
+void Entity::setBoundingBox(double width, double height) {
+	this->registry->setExtent(this->registryIndex, width, height);
 }
 
-BoundingBox * Entity::getBoundingBox() {
-	return this->boundingBox;
+bool Entity::isIntersecting(Entity* other) {
+	return this->registry->isIntersecting(this->registryIndex, other->registryIndex);
 }
 
-void Entity::setBoundingBox(BoundingBox * boundingBox) {
-	this->boundingBox = boundingBox;
+bool Entity::isIntersecting(Entity* other, double width, double height) {
+	return this->registry->isIntersecting(this->registryIndex, other->registryIndex, width, height);
+}
+
+bool Entity::isSweptIntersecting(Entity* other, double fall, double otherFall) {
+	return this->registry->isSweptIntersecting(this->registryIndex, other->registryIndex, fall, otherFall);
 }
 
 bool Entity::getEnabled() {
-	return this->enabled;
+	return this->registry->isEnabled(this->registryIndex);
 }
 
 void Entity::setEnabled(bool enabled) {
-	this->enabled = enabled;
+	this->registry->setEnabled(this->registryIndex, enabled);
+}
+
+CharacterAction Entity::getAction() {
+	return this->registry->getAction(this->registryIndex);
+}
+
+void Entity::setAction(CharacterAction action) {
+	this->registry->setAction(this->registryIndex, action);
+}
+
+int Entity::getRegistryIndex() {
+	return this->registryIndex;
+}
+
+void Entity::setRegistryIndex(int index) {
+	this->registryIndex = index;
 }
 
+void Entity::wake() {
+	this->engine->getActiveEntities()->wake(this);
+}
+
+void Entity::sleep() {
+	this->engine->getActiveEntities()->sleep(this);
+}
+
+void Entity::sleepFor(int ticks) {
+	this->engine->getActiveEntities()->sleepFor(this, ticks);
+}
+
+bool Entity::isAwake() {
+	return this->engine->getActiveEntities()->isAwake(this);
+}
+
+int Entity::getActiveOrder() {
+	return this->activeOrder;
+}
+
+void Entity::setActiveOrder(int order) {
+	this->activeOrder = order;
+}
+
+void Entity::initFixedComponents() { }
+void Entity::updateFixedComponents(double dt, Profiler* profiler) { }
+void Entity::animateFixedComponents(double dt) { }
+void Entity::renderFixedComponents(double alpha) { }
+
 Entity::~Entity() {
 	for (auto it = this->components->begin(); it != this->components->end(); it++) {
 		delete *it;
 	}
 
 	delete this->components;
-	delete this->boundingBox;
+	this->registry->remove(this->registryIndex);
 }
\ No newline at end of file
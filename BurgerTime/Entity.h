@@ -3,42 +3,76 @@
 #include "Coordinate.h"
 #include "Receiver.h"
 #include "Component.h"
-#include "BoundingBox.h"
 
 enum CharacterAction { WALK_LEFT, WALK_RIGHT, GO_UPSTAIRS, GO_DOWNSTAIRS, STUNNED, DIE, CELEBRATE_VICTORY, NO_ACTION};
 
 class Component;
 class Engine;
+class EntityRegistry;
+class Profiler;
 
 class Entity : public Receiver {
 private:
-	bool enabled;
+	int registryIndex;
+	int activeOrder;
 
 protected:
 	Engine* engine;
-	Coordinate* position;
-	BoundingBox* boundingBox;
+	EntityRegistry* registry;
 	std::vector<Component*>* components;
 
 public:
 
+	Entity(Engine* engine, Coordinate position);
 	Entity(Engine* engine, Coordinate* position);
 	Entity(Engine* engine);
 
 	virtual void init();
 	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 	virtual void addComponent(Component* component);
 
 	Component* getComponent(int index);
 
-	Coordinate* getPosition();
+	Coordinate getPosition();
 	virtual void setPosition(Coordinate& position);
+	virtual void savePreviousPosition();
+	Coordinate getInterpolatedPosition(double alpha);
 
-	BoundingBox* getBoundingBox();
-	void setBoundingBox(BoundingBox* boundingBox);
+	Coordinate getVelocity();
+	void setVelocity(double x, double y);
+
+	Coordinate getBoundingBox();
+	void setBoundingBox(double width, double height);
+	bool isIntersecting(Entity* other);
+	bool isIntersecting(Entity* other, double width, double height);
+	bool isSweptIntersecting(Entity* other, double fall, double otherFall);
 
 	bool getEnabled();
 	void setEnabled(bool enabled);
 
+	CharacterAction getAction();
+	void setAction(CharacterAction action);
+
+	int getRegistryIndex();
+	void setRegistryIndex(int index);
+
+	// Only entities Game ticks can sleep; for the rest these do nothing
+	void wake();
+	void sleep();
+	void sleepFor(int ticks);
+	bool isAwake();
+
+	int getActiveOrder();
+	void setActiveOrder(int order);
+
 	virtual ~Entity();
+
+protected:
+	// Entity types with a ComponentSet run it here, ahead of the components added at runtime
+	virtual void initFixedComponents();
+	virtual void updateFixedComponents(double dt, Profiler* profiler);
+	virtual void animateFixedComponents(double dt);
+	virtual void renderFixedComponents(double alpha);
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "EntityRegistry.h"
+
+int EntityRegistry::add(Entity* owner, double x, double y) {
+	this->owners.push_back(owner);
+	this->positionX.push_back(x);
+	this->positionY.push_back(y);
+	this->previousX.push_back(x);
+	this->previousY.push_back(y);
+	this->velocityX.push_back(0);
+	this->velocityY.push_back(0);
+	this->extentX.push_back(0);
+	this->extentY.push_back(0);
+	this->enabled.push_back(1);
+	this->actions.push_back(NO_ACTION);
+	this->grids.push_back(nullptr);
+	this->gridSlots.push_back(-1);
+	this->sweeps.push_back(nullptr);
+	this->sweepSlots.push_back(-1);
+
+	return (int) this->owners.size() - 1;
+}
+
+void EntityRegistry::remove(int index) {
+	int last = (int) this->owners.size() - 1;
+
+	if (index != last) {
+		this->owners[index] = this->owners[last];
+		this->positionX[index] = this->positionX[last];
+		this->positionY[index] = this->positionY[last];
+		this->previousX[index] = this->previousX[last];
+		this->previousY[index] = this->previousY[last];
+		this->velocityX[index] = this->velocityX[last];
+		this->velocityY[index] = this->velocityY[last];
+		this->extentX[index] = this->extentX[last];
+		this->extentY[index] = this->extentY[last];
+		this->enabled[index] = this->enabled[last];
+		this->actions[index] = this->actions[last];
+		this->grids[index] = this->grids[last];
+		this->gridSlots[index] = this->gridSlots[last];
+		this->sweeps[index] = this->sweeps[last];
+		this->sweepSlots[index] = this->sweepSlots[last];
+
+		this->owners[index]->setRegistryIndex(index);
+	}
+
+	this->owners.pop_back();
+	this->positionX.pop_back();
+	this->positionY.pop_back();
+	this->previousX.pop_back();
+	this->previousY.pop_back();
+	this->velocityX.pop_back();
+	this->velocityY.pop_back();
+	this->extentX.pop_back();
+	this->extentY.pop_back();
+	this->enabled.pop_back();
+	this->actions.pop_back();
+	this->grids.pop_back();
+	this->gridSlots.pop_back();
+	this->sweeps.pop_back();
+	this->sweepSlots.pop_back();
+}
+
+int EntityRegistry::getSize() {
+	return (int) this->owners.size();
+}
+
+void EntityRegistry::savePreviousPositions() {
+	size_t count = this->owners.size();
+	double* x = this->positionX.data();
+	double* y = this->positionY.data();
+	double* previousX = this->previousX.data();
+	double* previousY = this->previousY.data();
+
+	for (size_t i = 0; i < count; i++) {
+		previousX[i] = x[i];
+		previousY[i] = y[i];
+	}
+}
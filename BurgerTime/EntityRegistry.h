@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include "SDL.h"
+#include "Entity.h"
+#include "PerformanceCounters.h"
+#include "CollisionGrid.h"
+#include "SweepAndPrune.h"
+
+class Entity;
+
+// Hot per-entity state kept in parallel arrays, indexed by Entity::getRegistryIndex. Removing an
+// entity moves the last one into its slot, so indices are only stable while nothing is removed.
+// Passes that treat every entity alike, like savePreviousPositions, run straight over the arrays.
+// Movement and collisions stay in each entity's components, since an entity moves and settles its
+// collisions before the next one moves and the replays depend on that order
+class EntityRegistry {
+	std::vector<Entity*> owners;
+	std::vector<double> positionX;
+	std::vector<double> positionY;
+	std::vector<double> previousX;
+	std::vector<double> previousY;
+	std::vector<double> velocityX;
+	std::vector<double> velocityY;
+	std::vector<double> extentX;
+	std::vector<double> extentY;
+	std::vector<Uint8> enabled;
+	std::vector<CharacterAction> actions;
+	std::vector<CollisionGrid*> grids;
+	std::vector<int> gridSlots;
+	std::vector<SweepAndPrune*> sweeps;
+	std::vector<int> sweepSlots;
+
+public:
+	int add(Entity* owner, double x, double y);
+	void remove(int index);
+	int getSize();
+
+	void savePreviousPositions();
+
+	Entity* getOwner(int index) { return this->owners[index]; }
+
+	double getX(int index) { return this->positionX[index]; }
+	double getY(int index) { return this->positionY[index]; }
+	void setPosition(int index, double x, double y) { this->positionX[index] = x; this->positionY[index] = y; this->moved(index); }
+	void setY(int index, double y) { this->positionY[index] = y; this->moved(index); }
+
+	double getPreviousX(int index) { return this->previousX[index]; }
+	double getPreviousY(int index) { return this->previousY[index]; }
+	void savePreviousPosition(int index) { this->previousX[index] = this->positionX[index]; this->previousY[index] = this->positionY[index]; }
+
+	double getVelocityX(int index) { return this->velocityX[index]; }
+	double getVelocityY(int index) { return this->velocityY[index]; }
+	void setVelocity(int index, double x, double y) { this->velocityX[index] = x; this->velocityY[index] = y; }
+
+	double getExtentX(int index) { return this->extentX[index]; }
+	double getExtentY(int index) { return this->extentY[index]; }
+	void setExtent(int index, double width, double height) { this->extentX[index] = width; this->extentY[index] = height; this->moved(index); }
+
+	bool isEnabled(int index) { return this->enabled[index] != 0; }
+	void setEnabled(int index, bool enabled) { this->enabled[index] = enabled ? 1 : 0; }
+
+	CharacterAction getAction(int index) { return this->actions[index]; }
+	void setAction(int index, CharacterAction action) { this->actions[index] = action; }
+
+	// The grid an entity is filed in; every position write refreshes it, so it never goes stale. An entity
+	// can only be filed in one grid
+	void setGrid(int index, CollisionGrid* grid, int slot) {
+		assert(this->grids[index] == nullptr || this->grids[index] == grid);
+
+		this->grids[index] = grid;
+		this->gridSlots[index] = slot;
+	}
+
+	// Likewise for the sweep a moving body is sorted in
+	void setSweep(int index, SweepAndPrune* sweep, int slot) { this->sweeps[index] = sweep; this->sweepSlots[index] = slot; }
+	int getSweepSlot(int index) { return this->sweepSlots[index]; }
+
+	// Boxes are centred on the positions; the second form swaps in an explicit size for the first box
+	bool isIntersecting(int first, int second) {
+		return this->isIntersecting(first, second, this->extentX[first], this->extentY[first]);
+	}
+
+	bool isIntersecting(int first, int second, double width, double height) {
+		PerformanceCounters::collisionTests++;
+
+		return std::abs(this->positionX[first] - this->positionX[second]) * 2 < width + this->extentX[second]
+			&& std::abs(this->positionY[first] - this->positionY[second]) * 2 < height + this->extentY[second];
+	}
+
+	// Like isIntersecting, for two boxes that have each come down the given distance this tick. True if
+	// they overlapped at any point on the way, so a fast fall cannot pass through the other box
+	bool isSweptIntersecting(int first, int second, double firstFall, double secondFall) {
+		PerformanceCounters::collisionTests++;
+
+		double endY = (this->positionY[first] - this->positionY[second]) * 2;
+		double startY = endY - (firstFall - secondFall) * 2;
+		double reachY = this->extentY[first] + this->extentY[second];
+
+		return std::abs(this->positionX[first] - this->positionX[second]) * 2 < this->extentX[first] + this->extentX[second]
+			&& std::fmin(startY, endY) < reachY && std::fmax(startY, endY) > -reachY;
+	}
+
+private:
+	void moved(int index) {
+		if (this->grids[index] != nullptr) {
+			this->grids[index]->refresh(this->gridSlots[index]);
+		}
+
+		if (this->sweeps[index] != nullptr) {
+			this->sweeps[index]->refresh(this->sweepSlots[index]);
+		}
+	}
+};
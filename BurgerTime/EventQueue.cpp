@@ -0,0 +1,94 @@
+#include "EventQueue.h"
+
+EventQueue::EventQueue(int capacity) {
+	size_t size = 1;
+
+	while (size < (size_t) capacity) {
+		size <<= 1;
+	}
+
+	this->buffer = new Cell[size];
+	this->mask = size - 1;
+
+	for (size_t i = 0; i < size; i++) {
+		this->buffer[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	this->enqueuePosition.store(0, std::memory_order_relaxed);
+	this->dequeuePosition.store(0, std::memory_order_relaxed);
+	this->dropped.store(0, std::memory_order_relaxed);
+	this->pushed.store(0, std::memory_order_relaxed);
+}
+
+bool EventQueue::push(const Event& event) {
+	size_t position = this->enqueuePosition.load(std::memory_order_relaxed);
+	Cell* cell;
+
+	for (;;) {
+		cell = &this->buffer[position & this->mask];
+
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+		// The cell is free for this position: claim it. Otherwise it still holds an
+		// unconsumed event from the previous lap (full), or another producer got here first
+		if (difference == 0) {
+			if (this->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			this->dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else {
+			position = this->enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->event = event;
+	cell->sequence.store(position + 1, std::memory_order_release);
+	this->pushed.fetch_add(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool EventQueue::pop(Event* event) {
+	size_t position = this->dequeuePosition.load(std::memory_order_relaxed);
+	Cell* cell = &this->buffer[position & this->mask];
+	size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+	if ((intptr_t) sequence - (intptr_t) (position + 1) < 0) {
+		return false;
+	}
+
+	*event = cell->event;
+	this->dequeuePosition.store(position + 1, std::memory_order_relaxed);
+	cell->sequence.store(position + this->mask + 1, std::memory_order_release);
+
+	return true;
+}
+
+// Approximate while producers are running, exact once they are quiet
+int EventQueue::getDepth() {
+	size_t enqueued = this->enqueuePosition.load(std::memory_order_relaxed);
+	size_t dequeued = this->dequeuePosition.load(std::memory_order_relaxed);
+
+	return enqueued > dequeued ? (int) (enqueued - dequeued) : 0;
+}
+
+int EventQueue::getCapacity() {
+	return (int) (this->mask + 1);
+}
+
+long EventQueue::getDropped() {
+	return this->dropped.load(std::memory_order_relaxed);
+}
+
+long EventQueue::getPushed() {
+	return this->pushed.load(std::memory_order_relaxed);
+}
+
+EventQueue::~EventQueue() {
+	delete[] this->buffer;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "MessageDispatcher.h"
+
+const int EVENT_QUEUE_CAPACITY = 1024;
+
+// Bounded multi-producer single-consumer queue (Vyukov). Any thread may push; only the
+// main thread pops. A full queue drops the event instead of blocking the producer
+class EventQueue {
+	struct Cell {
+		std::atomic<size_t> sequence;
+		Event event;
+	};
+
+	Cell* buffer;
+	size_t mask;
+	alignas(64) std::atomic<size_t> enqueuePosition;
+	alignas(64) std::atomic<size_t> dequeuePosition;
+	std::atomic<long> dropped;
+	std::atomic<long> pushed;
+
+public:
+	EventQueue(int capacity);
+
+	bool push(const Event& event);
+	bool pop(Event* event);
+
+	int getDepth();
+	int getCapacity();
+	long getDropped();
+	long getPushed();
+
+	~EventQueue();
+};
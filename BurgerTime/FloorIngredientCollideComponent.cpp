@@ -1,23 +1,46 @@
 #include "FloorIngredientCollideComponent.h"
+#include "IngredientEntity.h"
+#include "Engine.h"
+#include <cmath>
 
-FloorIngredientCollideComponent::FloorIngredientCollideComponent(Engine* engine, Entity* ingredient, std::vector<Entity*>* floors) : Component(engine, ingredient) {
+FloorIngredientCollideComponent::FloorIngredientCollideComponent(Engine* engine, IngredientEntity* ingredient, CollisionGrid* floors) : Component(engine, ingredient) {
+	this->ingredient = ingredient;
 	this->floors = floors;
 }
 
 void FloorIngredientCollideComponent::update(double dt) {
-	for (Entity* floor : *this->floors) {
-		BoundingBox* ingredientBox = this->entity->getBoundingBox();
-		BoundingBox* floorBox = floor->getBoundingBox();
-		double heightDiff = floor->getPosition()->getY() - this->entity->getPosition()->getY();
+	double fall = this->ingredient->getFallDistance();
+	Coordinate boundingBox = this->entity->getBoundingBox();
+	const std::vector<Entity*>& floors = this->floors->query(this->entity, boundingBox.getX(), boundingBox.getY() + fall * 2);
+	double landingY = INFINITY;
 
-		bool onFloor = ingredientBox->isIntersecting(this->entity->getPosition(), floor->getPosition(), floorBox)
-			&& heightDiff > 0 && heightDiff < 2;
+	// A long fall can pass more than one floor, and it stops at the first one it reaches
+	for (Entity* floor : floors) {
+		if (this->isLanding(floor, fall)) {
+			landingY = std::fmin(landingY, floor->getPosition().getY());
+		}
+	}
 
-		if (onFloor) {
+	for (Entity* floor : floors) {
+		Coordinate floorPosition = floor->getPosition();
+
+		if (floorPosition.getY() == landingY && this->isLanding(floor, fall)) {
 			this->entity->receive(INGREDIENT_ON_FLOOR);
-			this->entity->setPosition(*floor->getPosition());
+			this->entity->setPosition(floorPosition);
+
+			this->engine->getMessageDispatcher()->sendTo(floor, INGREDIENT_ON_FLOOR);
 
-			floor->receive(INGREDIENT_ON_FLOOR);
+			// The fall is over, the other floors only count if the ingredient now rests on them
+			fall = 0;
 		}
 	}
 }
+
+// The ingredient lands on a floor when its fall this tick went through the two pixels above the floor,
+// or with no fall, when it is within those two pixels
+bool FloorIngredientCollideComponent::isLanding(Entity* floor, double fall) {
+	double heightDiff = floor->getPosition().getY() - this->entity->getPosition().getY();
+
+	return this->entity->isIntersecting(floor, this->entity->getBoundingBox().getX(), this->entity->getBoundingBox().getY() + fall * 2)
+		&& heightDiff < 2 && heightDiff + fall > 0;
+}
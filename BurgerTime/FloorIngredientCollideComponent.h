@@ -1,12 +1,18 @@
 #pragma once
 #include "Component.h"
+#include "CollisionGrid.h"
+
+class IngredientEntity;
 
 class FloorIngredientCollideComponent : public Component {
-	std::vector<Entity*>* floors;
+	IngredientEntity* ingredient;
+	CollisionGrid* floors;
 
 public:
-	FloorIngredientCollideComponent(Engine* engine, Entity* ingredient, std::vector<Entity*>* floors);
+	FloorIngredientCollideComponent(Engine* engine, IngredientEntity* ingredient, CollisionGrid* floors);
 	
 	virtual void update(double dt);
-};
 
+private:
+	bool isLanding(Entity* floor, double fall);
+};
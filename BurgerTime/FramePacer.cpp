@@ -0,0 +1,111 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cstring>
+
+FramePacer::FramePacer() {
+	this->counterFrequency = (double)SDL_GetPerformanceFrequency();
+	this->countsPerFrame = 0;
+	this->nextDeadline = 0;
+	this->previousFrameStart = SDL_GetPerformanceCounter();
+
+	this->frameTimes = new double[FRAME_PACER_HISTORY]();
+	this->pacingErrors = new double[FRAME_PACER_HISTORY]();
+	this->sortBuffer = new double[FRAME_PACER_HISTORY]();
+	this->historyIndex = 0;
+	this->historySize = 0;
+	this->smoothedFrameTime = 0;
+}
+
+void FramePacer::setTargetFrameRate(double frameRate) {
+	this->countsPerFrame = frameRate > 0 ? this->counterFrequency / frameRate : 0;
+	this->nextDeadline = 0;
+}
+
+void FramePacer::waitForNextFrame() {
+	double pacingError = 0;
+
+	if (this->countsPerFrame > 0) {
+		double now = (double)SDL_GetPerformanceCounter();
+
+		if (this->nextDeadline == 0 || now - this->nextDeadline > this->countsPerFrame) {
+			this->nextDeadline = (double)this->previousFrameStart + this->countsPerFrame;
+		}
+
+		this->sleepUntil(this->nextDeadline);
+
+		pacingError = ((double)SDL_GetPerformanceCounter() - this->nextDeadline) * 1000 / this->counterFrequency;
+		this->nextDeadline += this->countsPerFrame;
+	}
+
+	Uint64 frameStart = SDL_GetPerformanceCounter();
+	double frameTime = (double)(frameStart - this->previousFrameStart) * 1000 / this->counterFrequency;
+	this->previousFrameStart = frameStart;
+
+	this->record(frameTime, pacingError);
+}
+
+double FramePacer::getSmoothedFrameRate() {
+	return this->smoothedFrameTime > 0 ? 1000 / this->smoothedFrameTime : 0;
+}
+
+double FramePacer::getFrameTimePercentile(double percentile) {
+	return this->percentile(this->frameTimes, percentile);
+}
+
+double FramePacer::getPacingErrorPercentile(double percentile) {
+	return this->percentile(this->pacingErrors, percentile);
+}
+
+void FramePacer::sleepUntil(double deadline) {
+	double spinCounts = FRAME_PACER_SPIN_MILLISECS * this->counterFrequency / 1000;
+	double remaining = deadline - (double)SDL_GetPerformanceCounter();
+
+	// Coarse sleep, then spin the last stretch the scheduler can't hit precisely
+	if (remaining > spinCounts) {
+		SDL_Delay((Uint32)((remaining - spinCounts) * 1000 / this->counterFrequency));
+	}
+
+	while ((double)SDL_GetPerformanceCounter() < deadline);
+}
+
+int FramePacer::getHistorySize() {
+	return this->historySize;
+}
+
+double FramePacer::getFrameTime(int age) {
+	return this->frameTimes[(this->historyIndex - 1 - age + 2 * FRAME_PACER_HISTORY) % FRAME_PACER_HISTORY];
+}
+
+void FramePacer::record(double frameTime, double pacingError) {
+	this->frameTimes[this->historyIndex] = frameTime;
+	this->pacingErrors[this->historyIndex] = pacingError;
+
+	this->historyIndex = (this->historyIndex + 1) % FRAME_PACER_HISTORY;
+	this->historySize = std::min(this->historySize + 1, FRAME_PACER_HISTORY);
+
+	if (this->smoothedFrameTime == 0) {
+		this->smoothedFrameTime = frameTime;
+	}
+	else {
+		this->smoothedFrameTime += (frameTime - this->smoothedFrameTime) * FRAME_PACER_SMOOTHING;
+	}
+}
+
+double FramePacer::percentile(double* samples, double percentile) {
+	if (this->historySize == 0) {
+		return 0;
+	}
+
+	int index = std::min((int)(percentile / 100 * this->historySize), this->historySize - 1);
+
+	memcpy(this->sortBuffer, samples, this->historySize * sizeof(double));
+	std::nth_element(this->sortBuffer, this->sortBuffer + index, this->sortBuffer + this->historySize);
+
+	return this->sortBuffer[index];
+}
+
+FramePacer::~FramePacer() {
+	delete[] this->frameTimes;
+	delete[] this->pacingErrors;
+	delete[] this->sortBuffer;
+}
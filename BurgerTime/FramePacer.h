@@ -0,0 +1,39 @@
+#pragma once
+#include "SDL.h"
+
+const int FRAME_PACER_HISTORY = 240;
+const double FRAME_PACER_SPIN_MILLISECS = 2.0;
+const double FRAME_PACER_SMOOTHING = 0.1;
+
+class FramePacer {
+	double counterFrequency;
+	double countsPerFrame;
+	double nextDeadline;
+	Uint64 previousFrameStart;
+
+	double* frameTimes;
+	double* pacingErrors;
+	double* sortBuffer;
+	int historyIndex;
+	int historySize;
+	double smoothedFrameTime;
+
+public:
+	FramePacer();
+
+	void setTargetFrameRate(double frameRate);
+	void waitForNextFrame();
+
+	double getSmoothedFrameRate();
+	double getFrameTimePercentile(double percentile);
+	double getPacingErrorPercentile(double percentile);
+	int getHistorySize();
+	double getFrameTime(int age);
+
+	~FramePacer();
+
+private:
+	void sleepUntil(double deadline);
+	void record(double frameTime, double pacingError);
+	double percentile(double* samples, double percentile);
+};
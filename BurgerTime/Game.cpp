@@ -2,7 +2,7 @@
 #include "Engine.h"
 #include "Entity.h"
 #include "Text.h"
-#include "FpsCounterComponent.h"
+#include "PerformanceOverlayComponent.h"
 #include "InputComponent.h"
 #include "BoxCollideComponent.h"
 #include "PlayerEntity.h"
@@ -10,52 +10,79 @@
 #include "PlayerRenderComponent.h"
 #include "LevelManager.h"
 #include "DishFakeFloorEntity.h"
+#include "TileEntity.h"
 #include "ScoreCounterComponent.h"
 #include "LivesTrackerEntity.h"
-#include "FloorCollideComponent.h"
+#include "WalkCollideComponent.h"
 #include "TextRenderComponent.h"
 #include "PepperCounterComponent.h"
 #include "SoundEffectsComponent.h"
 #include "PepperReloadEntity.h"
 
-const bool SHOW_FPS = false;
-
 Game::Game(Engine* engine) : Entity(engine) {
 	this->chosenLevel = new std::string("resources/levels/default.bgtm");
+	this->sharedLevel = nullptr;
+	this->arena = new LevelArena(LEVEL_ARENA_BLOCK_SIZE);
 }
 
+// Everything created from here on belongs to the level and is released with the arena
 void Game::init() {
+	LevelArenaScope scope(this->arena);
+
 	this->initFields();
-	this->createFpsCounter();
 	this->createGameComponents();
 	this->createPlayer();
 	this->createLevel();
 	this->createHUD();
+	this->buildCollision();
 	this->performSubscriptions();
 
 	this->addEntity(this->player);
-	this->addEntity(this->player->getPepper());
+	this->addStaticEntity(this->player->getPepper());
 
 	Entity::init();
 }
 
 void Game::update(double dt) {
+	MessageDispatcher* dispatcher = this->engine->getMessageDispatcher();
+
+	// Events posted by input handling between ticks
+	dispatcher->dispatch();
+
 	if (this->reset) {
 		this->freeResources(true);
 		this->init();
 	}
 
+	this->engine->getEntityRegistry()->savePreviousPositions();
+
 	this->waitForIntro(dt);
 
 	Entity::update(dt);
+	dispatcher->dispatch();
+
+	this->engine->getActiveEntities()->update(dt, this->engine->getProfiler());
+	dispatcher->dispatch();
+}
+
+void Game::animate(double dt) {
+	Entity::animate(dt);
 
 	for (auto it = this->entities->begin(); it != this->entities->end(); it++) {
-		(*it)->update(dt);
+		(*it)->animate(dt);
 	}
 }
 
-void Game::receive(Message message) {
-	switch (message) {
+void Game::render(double alpha) {
+	Entity::render(alpha);
+
+	for (auto it = this->entities->begin(); it != this->entities->end(); it++) {
+		(*it)->render(alpha);
+	}
+}
+
+void Game::receive(const Event& event) {
+	switch (event.message) {
 		case EXIT:
 			this->engine->stop();
 			break;
@@ -63,7 +90,7 @@ void Game::receive(Message message) {
 			this->lantern->setEnabled(!this->lantern->getEnabled());
 			break;
 		case INGREDIENT_FLOOR_HIT:
-			this->increaseScore(50);
+			this->increaseScore(event.value);
 			break;
 		case INGREDIENT_FINISHED:
 			this->ingredientFinished();
@@ -75,7 +102,7 @@ void Game::receive(Message message) {
 			this->increasePepper();
 			break;
 		case ENEMY_SQUASHED:
-			this->increaseScore(100);
+			this->increaseScore(event.value);
 			break;
 		case ENEMY_ATTACK:
 			this->freezeEnemies();
@@ -97,17 +124,61 @@ void Game::receive(Message message) {
 
 void Game::addEntity(Entity* entity) {
 	this->entities->push_back(entity);
+	this->engine->getActiveEntities()->add(entity);
+}
+
+// Drawn every frame but never updated, like the level geometry and the HUD
+void Game::addStaticEntity(Entity* entity) {
+	this->entities->push_back(entity);
+}
+
+void Game::setSharedLevel(LevelData* level) {
+	this->sharedLevel = level;
+}
+
+void Game::setLevelPath(const char* levelPath) {
+	delete this->chosenLevel;
+
+	this->chosenLevel = new std::string(levelPath);
+	this->sharedLevel = nullptr;
+}
+
+const char* Game::getLevelPath() {
+	return this->chosenLevel->c_str();
+}
+
+std::vector<Entity*>* Game::getIngredients() {
+	return this->ingredients;
+}
+
+int Game::getEntityCount() {
+	return (int)this->entities->size();
+}
+
+int Game::getActiveEntityCount() {
+	return this->engine->getActiveEntities()->getAwakeCount();
+}
+
+int Game::getEnabledEntityCount() {
+	int enabled = 0;
+
+	for (Entity* entity : *this->entities) {
+		enabled += entity->getEnabled() ? 1 : 0;
+	}
+
+	return enabled;
 }
 
 void Game::createPlayer() {
 	Coordinate* playerPos = new Coordinate();
 
-	this->player = new PlayerEntity(this->engine, playerPos, this->enemies, this);
-	this->setWalkingEntityColliders(this->player, true);
+	this->player = new PlayerEntity(this->engine, playerPos, this->bodies, this->geometry, this->ingredients, this);
+	this->players->push_back(this->player);
+	this->bodies->setGroup(BODY_PEPPER, this->player->getPepperList());
 
 	Sprite* lanternSprite = new Sprite(this->engine->getRenderer(), "resources/sprites/lantern.bmp");
 	this->lantern = new Entity(this->engine, playerPos);
-	this->lantern->addComponent(new RenderComponent(this->engine, this->lantern, lanternSprite));
+	this->lantern->addComponent(new RenderComponent(this->engine, this->player, lanternSprite));
 }
 
 void Game::createGameComponents() {
@@ -117,99 +188,86 @@ void Game::createGameComponents() {
 	this->addComponent(new SoundEffectsComponent(this->engine, this));
 }
 
-void Game::createFpsCounter() {
-	if (SHOW_FPS) {
-		Entity* fpsCounter = new Entity(this->engine, new Coordinate(10, 10));
-		Text* text = new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 8);
-
-		fpsCounter->addComponent(new FpsCounterComponent(this->engine, fpsCounter, text));
-		this->addEntity(fpsCounter);
-	}
-}
-
 void Game::createHUD() {
-	this->addEntity(this->lantern);
+	this->addStaticEntity(this->lantern);
 	this->lantern->setEnabled(false);
 
 	Entity* scoreText = new Entity(this->engine, new Coordinate(24, 0));
 	scoreText->addComponent(new ScoreCounterComponent(this->engine, scoreText, this));
-	this->addEntity(scoreText);
+	this->addStaticEntity(scoreText);
 
 	LivesTrackerEntity* livesTracker = new LivesTrackerEntity(this->engine, new Coordinate(8, 232), this);
-	this->addEntity(livesTracker);
+	this->addStaticEntity(livesTracker);
 
 	Entity* pepperText = new Entity(this->engine, new Coordinate(200, 0));
 	pepperText->addComponent(new PepperCounterComponent(this->engine, pepperText, this));
-	this->addEntity(pepperText);
+	this->addStaticEntity(pepperText);
 
 	Entity* controlsText = new Entity(this->engine, new Coordinate(8, 20));
 	controlsText->addComponent(new TextRenderComponent(this->engine, controlsText,
 		new std::string("NIGHT <N, LB>     LOAD <L, START>     RESET <R, RB>"),
 		new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 8)));
-	this->addEntity(controlsText);
+	this->addStaticEntity(controlsText);
 
 	this->gameOverText = new Entity(this->engine, new Coordinate(70, 120));
 	this->gameOverText->addComponent(new TextRenderComponent(this->engine, this->gameOverText, new std::string("GAME OVER"),
 		new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 16)));
 	this->gameOverText->setEnabled(false);
 
-	this->addEntity(this->gameOverText);
+	this->addStaticEntity(this->gameOverText);
+
+	Entity* performanceOverlay = new Entity(this->engine, new Coordinate(4, 32));
+	performanceOverlay->addComponent(new PerformanceOverlayComponent(this->engine, performanceOverlay, this,
+		new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 8)));
+	this->addStaticEntity(performanceOverlay);
 }
 
 void Game::createLevel() {
 	LevelManager manager(this);
 
-	manager.loadLevel(this->chosenLevel->c_str());
+	if (this->sharedLevel != nullptr) {
+		manager.loadLevel(this->sharedLevel);
+	}
+	else {
+		manager.loadLevel(this->chosenLevel->c_str());
+	}
+
 	this->addEndingLimit();
 
 	this->addEntity(new PepperReloadEntity(this->engine, this->player, this->stairs));
 }
 
-void Game::setWalkingEntityColliders(Entity* entity, bool isPlayer) {
-	FloorCollideComponent* floorBox = new FloorCollideComponent(this->engine, entity, ON_FLOOR, floors, isPlayer);
-	BoxCollideComponent* leftBox = new BoxCollideComponent(this->engine, entity, INTERSECT_LIMIT_LEFT, leftFloorsLimits);
-	BoxCollideComponent* rightBox = new BoxCollideComponent(this->engine, entity, INTERSECT_LIMIT_RIGHT, rightFloorsLimits);
-	BoxCollideComponent* stairsBox = new BoxCollideComponent(this->engine, entity, INTERSECT_STAIRS, stairs);
-	BoxCollideComponent* upStairsBox = new BoxCollideComponent(this->engine, entity, INTERSECT_UP_STAIRS, upStairsLimits);
-	BoxCollideComponent* downStairsBox = new BoxCollideComponent(this->engine, entity, INTERSECT_DOWN_STAIRS, downStairsLimits);
-
-	entity->addComponent(floorBox);
-	entity->addComponent(leftBox);
-	entity->addComponent(rightBox);
-	entity->addComponent(stairsBox);
-	entity->addComponent(upStairsBox);
-	entity->addComponent(downStairsBox);
+void Game::setWalkingEntityColliders(Entity* entity) {
+	entity->addComponent(new WalkCollideComponent(this->engine, entity, this->geometry, nullptr));
 }
 
 void Game::addFloor(Coordinate* position, int type) {
-	Entity* floor = new Entity(this->engine, position);
 	Sprite* floorSprite = new Sprite(this->engine->getRenderer(),
 		type == 0? "resources/sprites/floor1.bmp" : "resources/sprites/floor2.bmp");
+	Entity* floor = new TileEntity(this->engine, position, floorSprite);
 
-	floor->setBoundingBox(new BoundingBox(new Coordinate(16, 2)));
-	floor->addComponent(new RenderComponent(this->engine, floor, floorSprite));
+	floor->setBoundingBox(16, 2);
 
 	this->floors->push_back(floor);
-	this->addEntity(floor);
+	this->addStaticEntity(floor);
 
 	this->updateLimits(FLOOR, position);
 }
 
 void Game::addStair(Coordinate* position) {
-	Entity* stair = new Entity(this->engine, position);
 	Sprite* stairSprite = new Sprite(this->engine->getRenderer(), "resources/sprites/stairs.bmp");
+	Entity* stair = new TileEntity(this->engine, position, stairSprite);
 
-	stair->setBoundingBox(new BoundingBox(new Coordinate(1, 16)));
-	stair->addComponent(new RenderComponent(this->engine, stair, stairSprite));
+	stair->setBoundingBox(1, 16);
 
 	this->stairs->push_back(stair);
-	this->addEntity(stair);
+	this->addStaticEntity(stair);
 
 	this->updateLimits(STAIR, position);
 }
 
 void Game::addIngredient(Coordinate* position, Ingredient ingredient) {
-	IngredientEntity* ingredient1 = new IngredientEntity(this->engine, position, this->player, ingredient, this->ingredients, this->floors);
+	IngredientEntity* ingredient1 = new IngredientEntity(this->engine, position, ingredient, this->bodies, this->floorsGrid);
 
 	this->totalIngredients++;
 	this->ingredients->push_back(ingredient1);
@@ -217,22 +275,22 @@ void Game::addIngredient(Coordinate* position, Ingredient ingredient) {
 }
 
 void Game::addDish(Coordinate* position) {
-	Entity* dish = new Entity(this->engine, position);
 	Sprite* sprite = new Sprite(engine->getRenderer(), "resources/sprites/dish.bmp");
+	Entity* dish = new TileEntity(this->engine, position, sprite);
 
 	Coordinate* fakeFloorPosition = new Coordinate(position->getX(), position->getY());
 	DishFakeFloorEntity* fakeFloor = new DishFakeFloorEntity(this->engine, fakeFloorPosition);
 
-	dish->addComponent(new RenderComponent(engine, dish, sprite));
-
 	this->floors->push_back(fakeFloor);
-	this->addEntity(dish);
+	this->dishFloors->push_back(fakeFloor);
+	this->collisionOnly->push_back(fakeFloor);
+	this->addStaticEntity(dish);
 }
 
 void Game::addEnemy(Coordinate* position, EnemyType enemyType, double idleTime) {
-	EnemyEntity* enemy = new EnemyEntity(this->engine, position, enemyType, idleTime, this->player, this->ingredients);
+	EnemyEntity* enemy = new EnemyEntity(this->engine, position, enemyType, idleTime, this->player, this->bodies);
 
-	this->setWalkingEntityColliders(enemy, false);
+	this->setWalkingEntityColliders(enemy);
 	this->enemies->push_back(enemy);
 	this->addEntity(enemy);
 }
@@ -287,7 +345,7 @@ void Game::playerDied() {
 	if (this->lives <= 0) {
 		this->input->setEnabled(false);
 		this->gameOverText->setEnabled(true);
-		this->engine->getMessageDispatcher()->send(GAME_OVER);
+		this->engine->getMessageDispatcher()->post(GAME_OVER);
 	}
 	else {
 		this->player->respawn();
@@ -361,10 +419,11 @@ void Game::addEndingLimit() {
 }
 
 void Game::createFloorLimit(Coordinate* position, int type) {
-	Entity* limit = new Entity(this->engine, position);
-	limit->setBoundingBox(new BoundingBox(new Coordinate(16, 2)));
 	position->setY(position->getY() - 5);
 
+	Entity* limit = new Entity(this->engine, position);
+	limit->setBoundingBox(16, 2);
+
 	if (type == 0) {
 		//limit->addComponent(new RenderComponent(this->engine, limit, new Sprite(this->engine->getRenderer(), "resources/sprites/cheese (1).bmp")));
 		this->leftFloorsLimits->push_back(limit);
@@ -375,11 +434,12 @@ void Game::createFloorLimit(Coordinate* position, int type) {
 	}
 
 	//this->addEntity(limit);
+	this->collisionOnly->push_back(limit);
 }
 
 void Game::createStairLimit(Coordinate* position, int type) {
 	Entity* stairLimit = new Entity(this->engine, position);
-	stairLimit->setBoundingBox(new BoundingBox(new Coordinate(16, 2)));
+	stairLimit->setBoundingBox(16, 2);
 
 	if (type == 0) {
 		//stairLimit->addComponent(new RenderComponent(this->engine, stairLimit, new Sprite(this->engine->getRenderer(), "resources/sprites/top (1).bmp")));
@@ -391,11 +451,30 @@ void Game::createStairLimit(Coordinate* position, int type) {
 	}
 
 	//this->addEntity(stairLimit);
+	this->collisionOnly->push_back(stairLimit);
 }
 
 void Game::victory() {
 	this->input->setEnabled(false);
-	this->engine->getMessageDispatcher()->send(GAME_VICTORY);
+	this->engine->getMessageDispatcher()->post(GAME_VICTORY);
+}
+
+CollisionGrid* Game::createGrid(std::vector<Entity*>* colliders) {
+	CollisionGrid* grid = new CollisionGrid(this->engine, colliders);
+
+	this->grids->push_back(grid);
+
+	return grid;
+}
+
+// Components hold the grids, the geometry and the sweep from the start, but they are only filled once the whole level exists
+void Game::buildCollision() {
+	for (CollisionGrid* grid : *this->grids) {
+		grid->build();
+	}
+
+	this->geometry->bake();
+	this->bodies->build();
 }
 
 void Game::initFields() {
@@ -408,6 +487,29 @@ void Game::initFields() {
 	this->downStairsLimits = new std::vector<Entity*>();
 	this->ingredients = new std::vector<Entity*>();
 	this->enemies = new std::vector<Entity*>();
+	this->dishFloors = new std::vector<Entity*>();
+	this->players = new std::vector<Entity*>();
+	this->collisionOnly = new std::vector<Entity*>();
+
+	this->grids = new std::vector<CollisionGrid*>();
+	this->floorsGrid = this->createGrid(this->floors);
+
+	// The player and the enemies share one 16x16 size, the one the geometry is baked for
+	this->geometry = new LevelGeometry(this->engine, 16, 16);
+	this->geometry->setLayer(GEOMETRY_FLOOR, this->floors);
+	this->geometry->setLayer(GEOMETRY_LEFT_LIMIT, this->leftFloorsLimits);
+	this->geometry->setLayer(GEOMETRY_RIGHT_LIMIT, this->rightFloorsLimits);
+	this->geometry->setLayer(GEOMETRY_STAIR, this->stairs);
+	this->geometry->setLayer(GEOMETRY_UP_STAIR_LIMIT, this->upStairsLimits);
+	this->geometry->setLayer(GEOMETRY_DOWN_STAIR_LIMIT, this->downStairsLimits);
+	this->geometry->setMovingFloors(this->dishFloors);
+
+	// Everything that moves and collides with other moving things; the pepper joins with the player.
+	// Ingredients reach as far as they can fall in a tick, for the swept ingredient checks
+	this->bodies = new SweepAndPrune(this->engine);
+	this->bodies->setGroup(BODY_PLAYER, this->players);
+	this->bodies->setGroup(BODY_ENEMIES, this->enemies);
+	this->bodies->setGroup(BODY_INGREDIENTS, this->ingredients, INGREDIENT_FALL_VELOCITY);
 
 	this->input = new InputComponent(this->engine, this);
 	this->player = nullptr;
@@ -445,15 +547,32 @@ void Game::waitForIntro(double dt) {
 
 		if (this->introTime <= 0) {
 			this->input->setEnabled(true);
-			this->engine->getMessageDispatcher()->send(GAME_STARTED);
+			this->engine->getMessageDispatcher()->post(GAME_STARTED);
 		}
 	}
 }
 
 void Game::loadNewLevel() {
+	std::string* level;
+
+	if (this->engine->isReplaying()) {
+		const char* levelPath = this->engine->popReplayLevel();
+		level = levelPath != nullptr ? new std::string(levelPath) : nullptr;
+	}
+	else {
+		level = LevelManager(this).promptLevel();
+	}
+
+	if (level == nullptr) {
+		return;
+	}
+
+	this->engine->recordLevel(level->c_str());
+
 	delete this->chosenLevel;
 
-	this->chosenLevel = LevelManager(this).promptLevel();
+	this->chosenLevel = level;
+	this->sharedLevel = nullptr;
 	this->reset = true;
 }
 
@@ -470,8 +589,20 @@ void Game::freeResources(bool freeComponents) {
 		delete *it;
 	}
 
+	for (auto it = this->collisionOnly->begin(); it != this->collisionOnly->end(); it++) {
+		delete *it;
+	}
+
 	this->engine->getMessageDispatcher()->clear();
+	this->engine->getActiveEntities()->clear();
 
+	for (auto it = this->grids->begin(); it != this->grids->end(); it++) {
+		delete *it;
+	}
+
+	delete this->grids;
+	delete this->geometry;
+	delete this->bodies;
 	delete this->entities;
 	delete this->floors;
 	delete this->leftFloorsLimits;
@@ -481,10 +612,16 @@ void Game::freeResources(bool freeComponents) {
 	delete this->downStairsLimits;
 	delete this->ingredients;
 	delete this->enemies;
+	delete this->dishFloors;
+	delete this->players;
+	delete this->collisionOnly;
 	delete this->previousFieldPosition;
+
+	this->arena->reset();
 }
 
 Game::~Game() {
-	this->freeResources(false);
+	this->freeResources(true);
 	delete this->chosenLevel;
+	delete this->arena;
 }
\ No newline at end of file
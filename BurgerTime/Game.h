@@ -5,6 +5,11 @@
 #include "IngredientEntity.h"
 #include "InputComponent.h"
 #include "SDL_mixer.h"
+#include "LevelData.h"
+#include "LevelArena.h"
+#include "CollisionGrid.h"
+#include "LevelGeometry.h"
+#include "SweepAndPrune.h"
 
 class Engine;
 class Entity;
@@ -15,6 +20,8 @@ enum Ingredient;
 
 class Game : public Entity {
 	std::string* chosenLevel;
+	LevelData* sharedLevel;
+	LevelArena* arena;
 
 	std::vector<Entity*>* entities;
 	std::vector<Entity*>* floors;
@@ -25,6 +32,14 @@ class Game : public Entity {
 	std::vector<Entity*>* downStairsLimits;
 	std::vector<Entity*>* ingredients;
 	std::vector<Entity*>* enemies;
+	std::vector<Entity*>* dishFloors;
+	std::vector<Entity*>* players;
+	std::vector<Entity*>* collisionOnly;
+
+	std::vector<CollisionGrid*>* grids;
+	CollisionGrid* floorsGrid;
+	LevelGeometry* geometry;
+	SweepAndPrune* bodies;
 
 	PlayerEntity* player;
 	Entity* lantern;
@@ -48,8 +63,18 @@ public:
 
 	virtual void init();
 	virtual void update(double dt);
-	virtual void receive(Message message);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
+	using Receiver::receive;
+	virtual void receive(const Event& event);
 	void addEntity(Entity* entity);
+	void setSharedLevel(LevelData* level);
+	void setLevelPath(const char* levelPath);
+	int getEntityCount();
+	int getActiveEntityCount();
+	int getEnabledEntityCount();
+	const char* getLevelPath();
+	std::vector<Entity*>* getIngredients();
 
 	void addFloor(Coordinate* position, int type);
 	void addStair(Coordinate* position);
@@ -70,13 +95,14 @@ public:
 	virtual ~Game();
 
 private:
+	void addStaticEntity(Entity* entity);
+
 	void createPlayer();
 	void createGameComponents();
-	void createFpsCounter();
 	void createHUD();
 	void createLevel();
 
-	void setWalkingEntityColliders(Entity* entity, bool isPlayer);
+	void setWalkingEntityColliders(Entity* entity);
 
 	void updateLimits(Field newField, Coordinate* position);
 	void addStartingLimit(Field newField, Coordinate* position);
@@ -94,6 +120,9 @@ private:
 	void playerDied();
 	void victory();
 
+	CollisionGrid* createGrid(std::vector<Entity*>* colliders);
+	void buildCollision();
+
 	void initFields();
 	void performSubscriptions();
 	void waitForIntro(double dt);
@@ -2,45 +2,56 @@
 
 #include "IngredientEntity.h"
 #include "Sprite.h"
-#include "RenderComponent.h"
-#include "FloorCollideComponent.h"
+#include "TileEntity.h"
 #include "IngredientRigidBodyComponent.h"
 #include "FloorIngredientCollideComponent.h"
+#include "IngredientIngredientCollideComponent.h"
+#include "EntityRegistry.h"
 #include <string>
 
-IngredientEntity::IngredientEntity(Engine* engine, Coordinate* position, PlayerEntity* player, Ingredient ingredient, std::vector<Entity*>* ingredients, std::vector<Entity*>* floors) : Entity(engine, position) {
+IngredientEntity::IngredientEntity(Engine* engine, Coordinate* position, Ingredient ingredient, SweepAndPrune* bodies, CollisionGrid* floors) : Entity(engine, position) {
 	char spritePattern[1000];
 
-	this->player = player;
 	this->ingredientEntities = new std::vector<Entity*>();
 	this->pushedDown = new bool[4]();
 	this->falling = false;
+	this->fallDistance = 0;
 
 	this->getSpritePattern(spritePattern, ingredient);
 
 	for (int i = 0; i < 4; i++) {
 		Coordinate* partPosition = new Coordinate(position->getX() - 12 + i * 8, position->getY());
-		Entity* ingredientPart = new Entity(engine, partPosition);
 		char spritePath[1000];
 
 		snprintf(spritePath, 1000, spritePattern, i + 1);
 		Sprite* partSprite = new Sprite(engine->getRenderer(), spritePath);
-		ingredientPart->addComponent(new RenderComponent(engine, ingredientPart, partSprite, new Coordinate(0, -2)));
+		Entity* ingredientPart = new TileEntity(engine, partPosition, partSprite, new Coordinate(0, -2));
 
-		std::vector<Entity*>* wrappedPart = new std::vector<Entity*>();
-		wrappedPart->push_back(ingredientPart);
-		player->addComponent(new FloorCollideComponent(engine, player, (Message) (ON_INGREDIENT_1 + i), wrappedPart, false, this));
-
-		ingredientPart->setBoundingBox(new BoundingBox(new Coordinate(1, 2)));
+		ingredientPart->setBoundingBox(1, 2);
 
 		this->ingredientEntities->push_back(ingredientPart);
 	}
 
-	this->setBoundingBox(new BoundingBox(new Coordinate(32, 2)));
+	this->setBoundingBox(32, 2);
+
+	this->fixedComponents.set(new IngredientRigidBodyComponent(engine, this), new IngredientIngredientCollideComponent(engine, this, bodies),
+		new FloorIngredientCollideComponent(engine, this, floors));
+}
+
+void IngredientEntity::initFixedComponents() {
+	this->fixedComponents.init();
+}
+
+void IngredientEntity::updateFixedComponents(double dt, Profiler* profiler) {
+	this->fixedComponents.update(dt, profiler);
+}
+
+void IngredientEntity::animateFixedComponents(double dt) {
+	this->fixedComponents.animate(dt);
+}
 
-	this->addComponent(new IngredientRigidBodyComponent(engine, this));
-	this->addComponent(new BoxCollideComponent(engine, this, INGREDIENT_INGREDIENT_HIT, ingredients));
-	this->addComponent(new FloorIngredientCollideComponent(engine, this, floors));
+void IngredientEntity::renderFixedComponents(double alpha) {
+	this->fixedComponents.render(alpha);
 }
 
 void IngredientEntity::update(double dt) {
@@ -49,6 +60,27 @@ void IngredientEntity::update(double dt) {
 	for (Entity* ingredientPart : *this->ingredientEntities) {
 		ingredientPart->update(dt);
 	}
+
+	// Resting, it only changes when the player steps on it or another ingredient lands on it
+	if (!this->falling) {
+		this->sleep();
+	}
+}
+
+void IngredientEntity::animate(double dt) {
+	Entity::animate(dt);
+
+	for (Entity* ingredientPart : *this->ingredientEntities) {
+		ingredientPart->animate(dt);
+	}
+}
+
+void IngredientEntity::render(double alpha) {
+	Entity::render(alpha);
+
+	for (Entity* ingredientPart : *this->ingredientEntities) {
+		ingredientPart->render(alpha);
+	}
 }
 
 void IngredientEntity::receive(Message message) {
@@ -66,17 +98,40 @@ void IngredientEntity::receive(Message message) {
 }
 
 void IngredientEntity::setPosition(Coordinate& position) {
-	this->position->setY(position.getY());
+	this->registry->setY(this->getRegistryIndex(), position.getY());
 
 	for (int i = 0; i < 4; i++) {
-		this->ingredientEntities->at(i)->getPosition()->setY(position.getY() + (this->pushedDown[i]? 1 : 0));
+		Entity* ingredientPart = this->ingredientEntities->at(i);
+		this->registry->setY(ingredientPart->getRegistryIndex(), position.getY() + (this->pushedDown[i]? 1 : 0));
 	}
 }
 
+void IngredientEntity::savePreviousPosition() {
+	Entity::savePreviousPosition();
+
+	for (Entity* ingredientPart : *this->ingredientEntities) {
+		ingredientPart->savePreviousPosition();
+	}
+}
+
+// The four slices the player steps on, left to right
+std::vector<Entity*>* IngredientEntity::getParts() {
+	return this->ingredientEntities;
+}
+
 bool IngredientEntity::isFalling() {
 	return this->falling;
 }
 
+// How far the ingredient came down in its last update, which the collision components sweep over
+double IngredientEntity::getFallDistance() {
+	return this->fallDistance;
+}
+
+void IngredientEntity::setFallDistance(double distance) {
+	this->fallDistance = distance;
+}
+
 void IngredientEntity::getSpritePattern(char * destinationBuffer, Ingredient ingredient) {
 	switch (ingredient) {
 		case BREAD_BOTTOM:
@@ -103,7 +158,10 @@ void IngredientEntity::getSpritePattern(char * destinationBuffer, Ingredient ing
 void IngredientEntity::onPlayerStep(int i) {
 	if (i >= 0 && i < 4 && !this->pushedDown[i]) {
 		this->pushedDown[i] = true;
-		this->engine->getMessageDispatcher()->send(ON_INGREDIENT_1);
+		this->engine->getMessageDispatcher()->post(ON_INGREDIENT_1, this);
+
+		// The slice sinks in the ingredient's next update, so a resting ingredient wakes for one tick
+		this->wake();
 	}
 
 	bool allPushedDown = true;
@@ -113,28 +171,36 @@ void IngredientEntity::onPlayerStep(int i) {
 	}
 
 	this->falling = allPushedDown;
+
+	if (this->falling) {
+		this->wake();
+	}
 }
 
 void IngredientEntity::onFloorHit() {
 	this->falling = false;
+	this->fallDistance = 0;
 	
 	for (int i = 0; i < 4; i++) {
 		this->pushedDown[i] = false;
 	}
 
-	this->engine->getMessageDispatcher()->send(INGREDIENT_FLOOR_HIT);
+	this->engine->getMessageDispatcher()->post(INGREDIENT_FLOOR_HIT, this, INGREDIENT_FLOOR_HIT_SCORE);
 }
 
 void IngredientEntity::onIngredientHit() {
 	if (this->falling) {
-		Coordinate* position = this->getPosition();
-		position->setY(position->getY() - 4);
+		Coordinate position = this->getPosition();
+		position.setY(position.getY() - 4);
 
-		this->setPosition(*position);
-		this->engine->getMessageDispatcher()->send(INGREDIENT_INGREDIENT_HIT);
+		// The bounce undoes the fall, so the floors must not see it as still coming down
+		this->setPosition(position);
+		this->fallDistance = 0;
+		this->engine->getMessageDispatcher()->post(INGREDIENT_INGREDIENT_HIT, this);
 	}
 
 	this->falling = true;
+	this->wake();
 }
 
 IngredientEntity::~IngredientEntity() {
@@ -1,29 +1,50 @@
 #pragma once
 #include "PlayerEntity.h"
 #include "Game.h"
+#include "ComponentSet.h"
+#include "CollisionGrid.h"
 
 enum Ingredient {BREAD_BOTTOM, BREAD_TOP, CHEESE, LETTUCE, MEAT, TOMATO};
 
 class Game;
+class IngredientRigidBodyComponent;
+class IngredientIngredientCollideComponent;
+class FloorIngredientCollideComponent;
+
+typedef ComponentSet<IngredientRigidBodyComponent, IngredientIngredientCollideComponent, FloorIngredientCollideComponent> IngredientComponents;
 
 class IngredientEntity : public Entity {
-	PlayerEntity* player;
+	IngredientComponents fixedComponents;
 
 	std::vector<Entity*>* ingredientEntities;
 	bool* pushedDown;
 	bool falling;
+	double fallDistance;
 
 public:
-	IngredientEntity(Engine* engine, Coordinate* position, PlayerEntity* player, Ingredient ingredient, std::vector<Entity*>* ingredients, std::vector<Entity*>* floors);
+	IngredientEntity(Engine* engine, Coordinate* position, Ingredient ingredient, SweepAndPrune* bodies, CollisionGrid* floors);
 
 	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
+	using Receiver::receive;
 	virtual void receive(Message message);
 	virtual void setPosition(Coordinate& position);
+	virtual void savePreviousPosition();
 
+	std::vector<Entity*>* getParts();
 	bool isFalling();
+	double getFallDistance();
+	void setFallDistance(double distance);
 
 	~IngredientEntity();
 
+protected:
+	virtual void initFixedComponents();
+	virtual void updateFixedComponents(double dt, Profiler* profiler);
+	virtual void animateFixedComponents(double dt);
+	virtual void renderFixedComponents(double alpha);
+
 private:
 	void getSpritePattern(char* destinationBuffer, Ingredient ingredient);
 	void onPlayerStep(int i);
@@ -0,0 +1,33 @@
+#include "IngredientIngredientCollideComponent.h"
+#include "IngredientEntity.h"
+#include "Engine.h"
+
+IngredientIngredientCollideComponent::IngredientIngredientCollideComponent(Engine* engine, IngredientEntity* ingredient, SweepAndPrune* bodies) : Component(engine, ingredient) {
+	this->ingredient = ingredient;
+	this->bodies = bodies;
+}
+
+void IngredientIngredientCollideComponent::update(double dt) {
+	for (Entity* collider : this->bodies->query(this->entity, BODY_INGREDIENTS)) {
+		IngredientEntity* other = (IngredientEntity*)collider;
+		double fall = this->ingredient->getFallDistance();
+		double otherFall = other->getFallDistance();
+
+		// Each fall is the distance the ingredient came down since the other one last looked, so a
+		// fall longer than an ingredient is thick cannot pass through
+		if (this->entity != other && other->getEnabled() && this->entity->isSweptIntersecting(other, fall, otherFall)) {
+			// One that went right through is put back level with the other, before it bounces off
+			if (!this->entity->isIntersecting(other)) {
+				IngredientEntity* faller = fall > otherFall ? this->ingredient : other;
+				IngredientEntity* hit = faller == other ? this->ingredient : other;
+				Coordinate position = faller->getPosition();
+
+				position.setY(hit->getPosition().getY());
+				faller->setPosition(position);
+			}
+
+			this->entity->receive(INGREDIENT_INGREDIENT_HIT);
+			this->engine->getMessageDispatcher()->sendTo(other, INGREDIENT_INGREDIENT_HIT);
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "Component.h"
+#include "SweepAndPrune.h"
+
+class IngredientEntity;
+
+class IngredientIngredientCollideComponent : public Component {
+	IngredientEntity* ingredient;
+	SweepAndPrune* bodies;
+
+public:
+	IngredientIngredientCollideComponent(Engine* engine, IngredientEntity* ingredient, SweepAndPrune* bodies);
+
+	virtual void update(double dt);
+};
@@ -2,14 +2,18 @@
 #include "IngredientEntity.h"
 #include "Constants.h"
 
-IngredientRigidBodyComponent::IngredientRigidBodyComponent(Engine* engine, Entity* entity) : RigidBodyComponent(engine, entity) { }
+IngredientRigidBodyComponent::IngredientRigidBodyComponent(Engine* engine, IngredientEntity* ingredient) : RigidBodyComponent(engine, ingredient) {
+	this->ingredient = ingredient;
+}
 
 void IngredientRigidBodyComponent::update(double dt) {
-	if (((IngredientEntity*)this->entity)->isFalling()) {
-		this->velocity->setY(INGREDIENT_FALL_VELOCITY);
+	if (this->ingredient->isFalling()) {
+		this->entity->setVelocity(0, INGREDIENT_FALL_VELOCITY);
+		this->ingredient->setFallDistance(INGREDIENT_FALL_VELOCITY * dt);
 	}
 	else {
-		this->velocity->setY(0);
+		this->entity->setVelocity(0, 0);
+		this->ingredient->setFallDistance(0);
 	}
 
 	RigidBodyComponent::update(dt);
@@ -1,9 +1,13 @@
 #pragma once
 #include "RigidBodyComponent.h"
+
+class IngredientEntity;
+
 class IngredientRigidBodyComponent : public RigidBodyComponent {
+	IngredientEntity* ingredient;
 
 public:
-	IngredientRigidBodyComponent(Engine* engine, Entity* entity);
+	IngredientRigidBodyComponent(Engine* engine, IngredientEntity* ingredient);
 
 	virtual void update(double dt);
 };
@@ -0,0 +1,29 @@
+#include "IngredientStepComponent.h"
+#include "IngredientEntity.h"
+#include "Engine.h"
+
+IngredientStepComponent::IngredientStepComponent(Engine* engine, Entity* entity, std::vector<Entity*>* ingredients) : Component(engine, entity) {
+	this->ingredients = ingredients;
+}
+
+void IngredientStepComponent::update(double dt) {
+	for (Entity* collider : *this->ingredients) {
+		IngredientEntity* ingredient = (IngredientEntity*)collider;
+		std::vector<Entity*>* parts = ingredient->getParts();
+
+		for (int i = 0; i < (int)parts->size(); i++) {
+			Entity* part = parts->at(i);
+			double heightDiff = part->getPosition().getY() - this->entity->getPosition().getY();
+
+			bool onPart = this->entity->isIntersecting(part)
+				&& heightDiff > 6.5 && heightDiff < 9.5;
+
+			if (onPart) {
+				Message message = (Message)(ON_INGREDIENT_1 + i);
+
+				this->entity->receive(message);
+				this->engine->getMessageDispatcher()->sendTo(ingredient, message);
+			}
+		}
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <vector>
+#include "Component.h"
+
+// Tells every ingredient which of its four slices the entity is standing on
+class IngredientStepComponent : public Component {
+	std::vector<Entity*>* ingredients;
+
+public:
+	IngredientStepComponent(Engine* engine, Entity* entity, std::vector<Entity*>* ingredients);
+
+	virtual void update(double dt);
+};
@@ -0,0 +1,188 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include "InputRecording.h"
+#include <cstdio>
+
+const Uint32 INPUT_RECORDING_MAGIC = 0x52495442;
+const Uint32 INPUT_RECORDING_VERSION = 1;
+
+InputRecording::InputRecording(Uint64 seed, int ticksPerSecond) {
+	this->seed = seed;
+	this->ticksPerSecond = ticksPerSecond;
+	this->length = 0;
+	this->levels = new std::vector<std::string>();
+	this->events = new std::vector<InputEvent>();
+	this->nextEvent = 0;
+	this->nextLevel = 0;
+}
+
+InputRecording* InputRecording::load(const char* path) {
+	FILE* fp = fopen(path, "rb");
+	Uint32 header[4];
+	Uint64 seed;
+
+	if (fp == nullptr) {
+		return nullptr;
+	}
+
+	if (fread(header, sizeof(Uint32), 4, fp) != 4 || fread(&seed, sizeof(Uint64), 1, fp) != 1
+		|| header[0] != INPUT_RECORDING_MAGIC || header[1] != INPUT_RECORDING_VERSION) {
+		fclose(fp);
+		return nullptr;
+	}
+
+	InputRecording* recording = new InputRecording(seed, (int)header[2]);
+	Uint64 count, value, tick = 0;
+	bool valid = readVarint(fp, &count);
+
+	recording->setLength(header[3]);
+
+	for (Uint64 i = 0; valid && i < count; i++) {
+		char levelPath[1000];
+		valid = readVarint(fp, &value) && value < sizeof(levelPath) && fread(levelPath, 1, (size_t)value, fp) == value;
+
+		if (valid) {
+			levelPath[value] = '\0';
+			recording->addLevel(levelPath);
+		}
+	}
+
+	valid = valid && readVarint(fp, &count);
+
+	for (Uint64 i = 0; valid && i < count; i++) {
+		Uint64 type = 0, code = 0;
+		valid = readVarint(fp, &value) && readVarint(fp, &type) && readVarint(fp, &code);
+
+		if (!valid) {
+			break;
+		}
+
+		tick += value;
+
+		// Codes are zigzag encoded so negative keycodes stay small
+		Sint32 decoded = (Sint32)((code >> 1) ^ (~(code & 1) + 1));
+		recording->addEvent({ (Uint32)tick, (InputEventType)type, decoded, 0 });
+	}
+
+	fclose(fp);
+
+	if (!valid) {
+		delete recording;
+		return nullptr;
+	}
+
+	return recording;
+}
+
+bool InputRecording::save(const char* path) {
+	FILE* fp = fopen(path, "wb");
+	Uint32 header[4] = { INPUT_RECORDING_MAGIC, INPUT_RECORDING_VERSION, (Uint32)this->ticksPerSecond, this->length };
+	Uint32 previousTick = 0;
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	fwrite(header, sizeof(Uint32), 4, fp);
+	fwrite(&this->seed, sizeof(Uint64), 1, fp);
+
+	writeVarint(fp, this->levels->size());
+
+	for (std::string& level : *this->levels) {
+		writeVarint(fp, level.size());
+		fwrite(level.c_str(), 1, level.size(), fp);
+	}
+
+	writeVarint(fp, this->events->size());
+
+	for (InputEvent& event : *this->events) {
+		writeVarint(fp, event.tick - previousTick);
+		writeVarint(fp, event.type);
+		writeVarint(fp, ((Uint32)event.code << 1) ^ (Uint32)(event.code >> 31));
+
+		previousTick = event.tick;
+	}
+
+	fclose(fp);
+
+	return true;
+}
+
+void InputRecording::addEvent(InputEvent event) {
+	this->events->push_back(event);
+}
+
+void InputRecording::addLevel(const char* levelPath) {
+	this->levels->push_back(levelPath);
+}
+
+void InputRecording::setLength(Uint32 length) {
+	this->length = length;
+}
+
+bool InputRecording::popEvent(Uint32 tick, InputEvent* event) {
+	if (this->nextEvent < this->events->size() && this->events->at(this->nextEvent).tick <= tick) {
+		*event = this->events->at(this->nextEvent++);
+		return true;
+	}
+
+	return false;
+}
+
+const char* InputRecording::popLevel() {
+	if (this->nextLevel < this->levels->size()) {
+		return this->levels->at(this->nextLevel++).c_str();
+	}
+
+	return nullptr;
+}
+
+Uint64 InputRecording::getSeed() {
+	return this->seed;
+}
+
+int InputRecording::getTicksPerSecond() {
+	return this->ticksPerSecond;
+}
+
+Uint32 InputRecording::getLength() {
+	return this->length;
+}
+
+void InputRecording::writeVarint(FILE* fp, Uint64 value) {
+	do {
+		Uint8 byte = value & 0x7F;
+		value >>= 7;
+
+		if (value != 0) {
+			byte |= 0x80;
+		}
+
+		fputc(byte, fp);
+	} while (value != 0);
+}
+
+bool InputRecording::readVarint(FILE* fp, Uint64* value) {
+	int shift = 0;
+	int byte;
+
+	*value = 0;
+
+	do {
+		byte = fgetc(fp);
+
+		if (byte == EOF || shift > 63) {
+			return false;
+		}
+
+		*value |= (Uint64)(byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+
+	return true;
+}
+
+InputRecording::~InputRecording() {
+	delete this->levels;
+	delete this->events;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+enum InputEventType { INPUT_KEY_DOWN, INPUT_KEY_UP, INPUT_CONTROLLER_DOWN, INPUT_CONTROLLER_UP, INPUT_CONTROLLER_HAT };
+
+struct InputEvent {
+	Uint32 tick;
+	InputEventType type;
+	Sint32 code;
+	Uint32 timestamp;
+};
+
+class InputRecording {
+	Uint64 seed;
+	int ticksPerSecond;
+	Uint32 length;
+
+	std::vector<std::string>* levels;
+	std::vector<InputEvent>* events;
+	size_t nextEvent;
+	size_t nextLevel;
+
+public:
+	InputRecording(Uint64 seed, int ticksPerSecond);
+
+	static InputRecording* load(const char* path);
+	bool save(const char* path);
+
+	void addEvent(InputEvent event);
+	void addLevel(const char* levelPath);
+	void setLength(Uint32 length);
+
+	bool popEvent(Uint32 tick, InputEvent* event);
+	const char* popLevel();
+
+	Uint64 getSeed();
+	int getTicksPerSecond();
+	Uint32 getLength();
+
+	~InputRecording();
+
+private:
+	static void writeVarint(FILE* fp, Uint64 value);
+	static bool readVarint(FILE* fp, Uint64* value);
+};
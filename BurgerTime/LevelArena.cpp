@@ -0,0 +1,81 @@
+#include "LevelArena.h"
+#include <cstdlib>
+
+thread_local LevelArena* LevelArena::current = nullptr;
+
+LevelArena::LevelArena(size_t blockSize) {
+	this->blocks = new std::vector<char*>();
+	this->blockSizes = new std::vector<size_t>();
+	this->blockSize = blockSize;
+	this->currentBlock = 0;
+	this->offset = 0;
+	this->used = 0;
+	this->peak = 0;
+}
+
+void* LevelArena::allocate(size_t size) {
+	size = (size + LEVEL_ARENA_ALIGNMENT - 1) & ~(LEVEL_ARENA_ALIGNMENT - 1);
+
+	// Move on to the next block that can hold it, keeping blocks left over from earlier levels
+	while (this->currentBlock < this->blocks->size() && this->offset + size > (*this->blockSizes)[this->currentBlock]) {
+		this->currentBlock++;
+		this->offset = 0;
+	}
+
+	if (this->currentBlock == this->blocks->size()) {
+		this->addBlock(size);
+	}
+
+	char* pointer = (*this->blocks)[this->currentBlock] + this->offset;
+
+	this->offset += size;
+	this->used += size;
+
+	if (this->used > this->peak) {
+		this->peak = this->used;
+	}
+
+	return pointer;
+}
+
+void LevelArena::reset() {
+	this->currentBlock = 0;
+	this->offset = 0;
+	this->used = 0;
+}
+
+size_t LevelArena::getUsed() {
+	return this->used;
+}
+
+size_t LevelArena::getPeak() {
+	return this->peak;
+}
+
+int LevelArena::getBlockCount() {
+	return (int) this->blocks->size();
+}
+
+LevelArena* LevelArena::getCurrent() {
+	return current;
+}
+
+void LevelArena::setCurrent(LevelArena* arena) {
+	current = arena;
+}
+
+void LevelArena::addBlock(size_t minimumSize) {
+	size_t size = minimumSize > this->blockSize ? minimumSize : this->blockSize;
+
+	this->blocks->push_back((char*) malloc(size));
+	this->blockSizes->push_back(size);
+}
+
+LevelArena::~LevelArena() {
+	for (char* block : *this->blocks) {
+		free(block);
+	}
+
+	delete this->blocks;
+	delete this->blockSizes;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+const size_t LEVEL_ARENA_BLOCK_SIZE = 256 * 1024;
+const size_t LEVEL_ARENA_ALIGNMENT = 16;
+
+// Bump allocator for everything a level creates. Memory is never handed back piece by piece:
+// reset() rewinds to the first block in one step and keeps the blocks for the next level
+class LevelArena {
+	std::vector<char*>* blocks;
+	std::vector<size_t>* blockSizes;
+	size_t blockSize;
+	size_t currentBlock;
+	size_t offset;
+	size_t used;
+	size_t peak;
+
+	static thread_local LevelArena* current;
+
+public:
+	LevelArena(size_t blockSize);
+
+	void* allocate(size_t size);
+	void reset();
+
+	size_t getUsed();
+	size_t getPeak();
+	int getBlockCount();
+
+	static LevelArena* getCurrent();
+	static void setCurrent(LevelArena* arena);
+
+	~LevelArena();
+
+private:
+	void addBlock(size_t minimumSize);
+};
+
+// Routes ArenaObject allocations on this thread into the arena until it goes out of scope
+class LevelArenaScope {
+	LevelArena* previous;
+
+public:
+	LevelArenaScope(LevelArena* arena) {
+		this->previous = LevelArena::getCurrent();
+		LevelArena::setCurrent(arena);
+	}
+
+	~LevelArenaScope() {
+		LevelArena::setCurrent(this->previous);
+	}
+};
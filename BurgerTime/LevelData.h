@@ -0,0 +1,10 @@
+#pragma once
+#include <vector>
+
+struct LevelEntry {
+	char type[50];
+	int position[2];
+	int extra;
+};
+
+typedef std::vector<LevelEntry> LevelData;
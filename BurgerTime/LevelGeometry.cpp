@@ -0,0 +1,186 @@
+#include "LevelGeometry.h"
+#include "Engine.h"
+#include "EntityRegistry.h"
+#include "CollisionGrid.h"
+#include "Constants.h"
+#include "BoxKernel.h"
+#include <cmath>
+#include <climits>
+#include <algorithm>
+
+LevelGeometry::LevelGeometry(Engine* engine, double walkerWidth, double walkerHeight) {
+	this->registry = engine->getEntityRegistry();
+	this->walkerWidth = walkerWidth;
+	this->walkerHeight = walkerHeight;
+	this->columns = ORIGINAL_WIDTH / COLLISION_CELL_SIZE;
+	this->rows = ORIGINAL_HEIGHT / COLLISION_CELL_SIZE;
+	this->movingFloors = nullptr;
+
+	for (int kind = 0; kind < GEOMETRY_KINDS; kind++) {
+		this->layers[kind] = nullptr;
+	}
+}
+
+void LevelGeometry::setLayer(GeometryKind kind, std::vector<Entity*>* features) {
+	this->layers[kind] = features;
+}
+
+void LevelGeometry::setMovingFloors(std::vector<Entity*>* floors) {
+	this->movingFloors = floors;
+}
+
+// Counts the entries of every run first and fills them in a second pass. Both walk the layers in
+// the same order, so each run ends up sorted by position in its list
+void LevelGeometry::bake() {
+	int runs = this->columns * this->rows * GEOMETRY_KINDS;
+	std::vector<int> cursors(runs + 1, 0);
+
+	this->movingEntries.clear();
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (int kind = 0; kind < GEOMETRY_KINDS; kind++) {
+			std::vector<Entity*>* features = this->layers[kind];
+
+			for (int order = 0; features != nullptr && order < (int)features->size(); order++) {
+				Entity* feature = features->at(order);
+				int index = feature->getRegistryIndex();
+				double x = this->registry->getX(index);
+				double y = this->registry->getY(index);
+				double width = this->registry->getExtentX(index);
+				double height = this->registry->getExtentY(index);
+
+				if (kind == GEOMETRY_FLOOR && this->isMovingFloor(feature)) {
+					if (pass == 0) {
+						this->movingEntries.push_back({ feature, (GeometryKind)kind, order });
+					}
+
+					continue;
+				}
+
+				// Floors are also tested against a 16x8 box for the player's near floor check
+				double reachX = (this->walkerWidth + (kind == GEOMETRY_FLOOR ? std::fmax(width, 16) : width)) / 2;
+				double reachY = (this->walkerHeight + (kind == GEOMETRY_FLOOR ? std::fmax(height, 8) : height)) / 2;
+
+				for (int row = this->rowAt(y - reachY); row <= this->rowAt(y + reachY); row++) {
+					for (int column = this->columnAt(x - reachX); column <= this->columnAt(x + reachX); column++) {
+						int run = (row * this->columns + column) * GEOMETRY_KINDS + kind;
+
+						if (pass == 0) {
+							cursors[run + 1]++;
+						}
+						else {
+							int entry = cursors[run]++;
+
+							this->entries[entry] = { feature, (GeometryKind)kind, order };
+							this->entryX[entry] = x;
+							this->entryY[entry] = y;
+							this->entryWidth[entry] = width;
+							this->entryHeight[entry] = height;
+						}
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (int run = 0; run < runs; run++) {
+				cursors[run + 1] += cursors[run];
+			}
+
+			this->runStarts = cursors;
+			this->entries.resize(cursors[runs]);
+			this->entryX.resize(cursors[runs]);
+			this->entryY.resize(cursors[runs]);
+			this->entryWidth.resize(cursors[runs]);
+			this->entryHeight.resize(cursors[runs]);
+		}
+	}
+}
+
+// The first floor after the given list position that the walker could be on or near, or nullptr.
+// The cell is looked up again on every call because the player may have been pulled onto the last floor
+Entity* LevelGeometry::nextFloor(Entity* walker, int* order) {
+	int run = this->runOf(walker, GEOMETRY_FLOOR);
+	Entity* next = nullptr;
+	int nextOrder = INT_MAX;
+
+	for (int i = this->runStarts[run]; i < this->runStarts[run + 1]; i++) {
+		if (this->entries[i].order > *order) {
+			next = this->entries[i].feature;
+			nextOrder = this->entries[i].order;
+			break;
+		}
+	}
+
+	for (GeometryEntry& entry : this->movingEntries) {
+		if (entry.order > *order) {
+			if (entry.order < nextOrder) {
+				next = entry.feature;
+				nextOrder = entry.order;
+			}
+
+			break;
+		}
+	}
+
+	*order = nextOrder;
+
+	return next;
+}
+
+// The features never move once baked, so their packed copies can be tested in place of the entities
+bool LevelGeometry::isTouching(Entity* walker, GeometryKind kind) {
+	int run = this->runOf(walker, kind);
+	int index = walker->getRegistryIndex();
+	double x = this->registry->getX(index);
+	double y = this->registry->getY(index);
+	double width = this->registry->getExtentX(index);
+	double height = this->registry->getExtentY(index);
+
+	for (int first = this->runStarts[run]; first < this->runStarts[run + 1]; first += 64) {
+		PackedBoxes boxes = { this->entryX.data() + first, this->entryY.data() + first, this->entryWidth.data() + first,
+			this->entryHeight.data() + first, std::min(64, this->runStarts[run + 1] - first) };
+		Uint64 hits;
+
+		BoxKernel::intersect(x, y, width, height, boxes, &hits);
+
+		if (hits != 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool LevelGeometry::isMovingFloor(Entity* floor) {
+	for (size_t i = 0; this->movingFloors != nullptr && i < this->movingFloors->size(); i++) {
+		if (this->movingFloors->at(i) == floor) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int LevelGeometry::cellOf(Entity* walker) {
+	int index = walker->getRegistryIndex();
+
+	return this->rowAt(this->registry->getY(index)) * this->columns + this->columnAt(this->registry->getX(index));
+}
+
+int LevelGeometry::runOf(Entity* walker, GeometryKind kind) {
+	return this->cellOf(walker) * GEOMETRY_KINDS + kind;
+}
+
+// Like CollisionGrid, anything past the edge is kept in the border cells
+int LevelGeometry::columnAt(double x) {
+	int column = (int)std::floor(x / COLLISION_CELL_SIZE);
+
+	return column < 0 ? 0 : (column >= this->columns ? this->columns - 1 : column);
+}
+
+int LevelGeometry::rowAt(double y) {
+	int row = (int)std::floor(y / COLLISION_CELL_SIZE);
+
+	return row < 0 ? 0 : (row >= this->rows ? this->rows - 1 : row);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include "SDL.h"
+#include "ArenaObject.h"
+
+class Engine;
+class Entity;
+class EntityRegistry;
+
+enum GeometryKind { GEOMETRY_FLOOR, GEOMETRY_LEFT_LIMIT, GEOMETRY_RIGHT_LIMIT, GEOMETRY_STAIR, GEOMETRY_UP_STAIR_LIMIT,
+	GEOMETRY_DOWN_STAIR_LIMIT, GEOMETRY_KINDS };
+
+struct GeometryEntry {
+	Entity* feature;
+	GeometryKind kind;
+	int order;
+};
+
+// The level's floors, stairs and walk limits baked into one tile-sized table when the level loads.
+// Each cell lists the features a walker whose centre is in that cell could be touching, one run per
+// kind with the boxes packed for BoxKernel, so finding them is a single lookup. Floors that move,
+// like the ones on the dishes, are kept aside and always checked. Lookups assume the walker size
+// given at construction
+class LevelGeometry : public ArenaObject {
+	EntityRegistry* registry;
+	double walkerWidth;
+	double walkerHeight;
+	int columns;
+	int rows;
+
+	std::vector<Entity*>* layers[GEOMETRY_KINDS];
+	std::vector<Entity*>* movingFloors;
+
+	std::vector<int> runStarts;
+	std::vector<GeometryEntry> entries;
+	std::vector<double> entryX;
+	std::vector<double> entryY;
+	std::vector<double> entryWidth;
+	std::vector<double> entryHeight;
+	std::vector<GeometryEntry> movingEntries;
+
+public:
+	LevelGeometry(Engine* engine, double walkerWidth, double walkerHeight);
+
+	void setLayer(GeometryKind kind, std::vector<Entity*>* features);
+	void setMovingFloors(std::vector<Entity*>* floors);
+	void bake();
+
+	Entity* nextFloor(Entity* walker, int* order);
+	bool isTouching(Entity* walker, GeometryKind kind);
+
+private:
+	bool isMovingFloor(Entity* floor);
+	int cellOf(Entity* walker);
+	int runOf(Entity* walker, GeometryKind kind);
+	int columnAt(double x);
+	int rowAt(double y);
+};
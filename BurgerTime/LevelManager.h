@@ -1,5 +1,6 @@
 #pragma once
 #include "Game.h"
+#include "LevelData.h"
 #include <vector>
 #include <string>
 
@@ -10,7 +11,10 @@ class LevelManager {
 public:
 	LevelManager(Game* game);
 
+	static LevelData* parseLevel(const char* levelPath);
+
 	void loadLevel(const char* levelPath);
+	void loadLevel(LevelData* level);
 	std::string* promptLevel();
 
 private:
@@ -12,10 +12,18 @@ LivesTrackerEntity::LivesTrackerEntity(Engine* engine, Coordinate* position, Gam
 	}
 }
 
-void LivesTrackerEntity::update(double dt) {
-	Entity::update(dt);
+void LivesTrackerEntity::animate(double dt) {
+	Entity::animate(dt);
 
 	for (int i = 0; i < game->getLives() && i < MAX_LIVES; i++) {
-		this->sprites->at(i)->update(dt);
+		this->sprites->at(i)->animate(dt);
+	}
+}
+
+void LivesTrackerEntity::render(double alpha) {
+	Entity::render(alpha);
+
+	for (int i = 0; i < game->getLives() && i < MAX_LIVES; i++) {
+		this->sprites->at(i)->render(alpha);
 	}
 }
@@ -11,6 +11,7 @@ class LivesTrackerEntity : public Entity {
 public:
 	LivesTrackerEntity(Engine* engine, Coordinate* position, Game* game);
 
-	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 };
 
@@ -1,24 +1,290 @@
 #include "MessageDispatcher.h"
+#include "Entity.h"
+#include "EventQueue.h"
+#include <algorithm>
+#include <cstdio>
+
+static const char* MESSAGE_NAMES[Message::COUNT] = { "NULL_MESSAGE", "EXIT", "MOVE_LEFT", "MOVE_RIGHT", "MOVE_UP", "MOVE_DOWN", "MAIN_ACTION",
+	"SWITCH_NIGHT_MODE", "RESET_GAME", "LOAD_NEW_LEVEL", "ON_FLOOR", "NEAR_FLOOR", "ON_INGREDIENT_1", "ON_INGREDIENT_2", "ON_INGREDIENT_3",
+	"ON_INGREDIENT_4", "INGREDIENT_ON_FLOOR", "INGREDIENT_INGREDIENT_HIT", "INTERSECT_LIMIT_LEFT", "INTERSECT_LIMIT_RIGHT", "INTERSECT_STAIRS",
+	"INTERSECT_UP_STAIRS", "INTERSECT_DOWN_STAIRS", "INTERSECT_RELOAD_PEPPER", "ENEMY_ATTACK", "ENEMY_SQUASHED", "ENEMY_PEPPERED",
+	"ENEMY_UNPEPPERED", "PEPPER_THROWN", "INCREASE_PEPPER", "INGREDIENT_FLOOR_HIT", "INGREDIENT_FINISHED", "PLAYER_DIED", "GAME_STARTED",
+	"GAME_VICTORY", "GAME_OVER" };
 
 MessageDispatcher::MessageDispatcher() {
-	this->receivers = new std::vector<Receiver*>[Message::COUNT]();
+	this->subscribers = new std::vector<Subscriber>[Message::COUNT]();
+	this->slots = new std::vector<SubscriptionSlot>();
+	this->freeSlots = new std::vector<Uint32>();
+	this->deferredUnsubscribes = new std::vector<Subscription>();
+	this->pending = new std::vector<Event>();
+	this->posted = new std::vector<Event>();
+	this->dispatching = new std::vector<Event>();
+	this->pending->reserve(INITIAL_EVENT_CAPACITY);
+	this->posted->reserve(INITIAL_EVENT_CAPACITY);
+	this->dispatching->reserve(INITIAL_EVENT_CAPACITY);
+	this->queued = new EventQueue(EVENT_QUEUE_CAPACITY);
+	this->maxQueueDepth = 0;
+	this->delivering = false;
+
+	this->resetFanOutStats();
+}
+
+Subscription MessageDispatcher::subscribe(Message message, Receiver * receiver) {
+	Uint32 slot;
+
+	if (this->freeSlots->empty()) {
+		slot = (Uint32) this->slots->size();
+		this->slots->push_back({ nullptr, NULL_MESSAGE, 0, -1 });
+	}
+	else {
+		slot = this->freeSlots->back();
+		this->freeSlots->pop_back();
+	}
+
+	SubscriptionSlot& entry = (*this->slots)[slot];
+	entry.receiver = receiver;
+	entry.message = message;
+	entry.position = (int) this->subscribers[message].size();
+
+	this->subscribers[message].push_back({ receiver, slot });
+
+	return { slot, entry.generation };
+}
+
+// O(1): the last subscriber of the same message takes the removed one's place. While
+// dispatching, the receiver is only muted and the removal waits until delivery finishes
+void MessageDispatcher::unsubscribe(Subscription subscription) {
+	if (!this->isSubscribed(subscription)) {
+		return;
+	}
+
+	SubscriptionSlot& entry = (*this->slots)[subscription.slot];
+
+	if (this->delivering) {
+		this->subscribers[entry.message][entry.position].receiver = nullptr;
+		this->deferredUnsubscribes->push_back(subscription);
+		return;
+	}
+
+	this->removeSubscriber(subscription.slot);
+}
+
+bool MessageDispatcher::isSubscribed(Subscription subscription) {
+	return subscription.slot < this->slots->size() && (*this->slots)[subscription.slot].generation == subscription.generation
+		&& (*this->slots)[subscription.slot].position >= 0;
+}
+
+void MessageDispatcher::removeSubscriber(Uint32 slot) {
+	SubscriptionSlot& entry = (*this->slots)[slot];
+	std::vector<Subscriber>& list = this->subscribers[entry.message];
+	Subscriber last = list.back();
+
+	list[entry.position] = last;
+	(*this->slots)[last.slot].position = entry.position;
+	list.pop_back();
+
+	entry.receiver = nullptr;
+	entry.position = -1;
+	entry.generation++;
+	this->freeSlots->push_back(slot);
+}
+
+void MessageDispatcher::post(Message message) {
+	this->post({ message, nullptr, nullptr, 0, 0, 0 });
+}
+
+void MessageDispatcher::post(Message message, Entity* sender, int value) {
+	Coordinate position = sender->getPosition();
+
+	this->post({ message, sender, nullptr, position.getX(), position.getY(), value });
+}
+
+void MessageDispatcher::post(Event event) {
+	this->pending->push_back(event);
+	this->stats[event.message].events++;
+}
+
+void MessageDispatcher::postTo(Receiver* target, Message message, Entity* sender, int value) {
+	double x = 0, y = 0;
+
+	if (sender != nullptr) {
+		Coordinate position = sender->getPosition();
+
+		x = position.getX();
+		y = position.getY();
+	}
+
+	this->post({ message, sender, target, x, y, value });
+}
+
+// Immediate delivery to a single receiver, for collision responses that must be seen in the same tick
+void MessageDispatcher::sendTo(Receiver* target, Message message) {
+	this->stats[message].events++;
+	this->stats[message].deliveries++;
+
+	target->receive(message);
+}
+
+// Safe to call from any thread. Returns false when the queue is full and the event was dropped.
+// Queued events carry no sender or target, so one that outlives a level reset has nothing to dangle
+bool MessageDispatcher::postFromThread(Message message, int value) {
+	return this->queued->push({ message, nullptr, nullptr, 0, 0, value });
+}
+
+// Main thread only: moves what other threads queued into the normal deferred path. At most one
+// queue's worth is taken per call so a busy producer can't keep the tick from finishing
+int MessageDispatcher::drainQueued() {
+	int depth = this->queued->getDepth();
+	int drained = 0;
+	Event event;
+
+	this->maxQueueDepth = std::max(this->maxQueueDepth, depth);
+
+	while (drained < this->queued->getCapacity() && this->queued->pop(&event)) {
+		this->post(event);
+		drained++;
+	}
+
+	return drained;
 }
 
-void MessageDispatcher::subscribe(Message message, Receiver * receiver) {
-	this->receivers[message].push_back(receiver);
+// Delivers everything posted since the last call, one message type at a time. Events posted
+// while delivering are handled in a following round so no handler ever runs re-entrantly
+void MessageDispatcher::dispatch() {
+	this->delivering = true;
+
+	for (int round = 0; round < MAX_DISPATCH_ROUNDS && !this->pending->empty(); round++) {
+		std::swap(this->pending, this->posted);
+		this->groupByMessage();
+
+		// Events of one type stay in posting order, whether they are targeted or broadcast
+		for (const Event& event : *this->dispatching) {
+			FanOutStats& stats = this->stats[event.message];
+
+			if (event.target != nullptr) {
+				event.target->receive(event);
+				stats.deliveries++;
+			}
+			else {
+				std::vector<Subscriber>& list = this->subscribers[event.message];
+
+				for (size_t i = 0; i < list.size(); i++) {
+					if (list[i].receiver != nullptr) {
+						list[i].receiver->receive(event);
+						stats.deliveries++;
+					}
+				}
+			}
+		}
+
+		this->dispatching->clear();
+	}
+
+	this->delivering = false;
+
+	for (Subscription subscription : *this->deferredUnsubscribes) {
+		if (this->isSubscribed(subscription)) {
+			this->removeSubscriber(subscription.slot);
+		}
+	}
+
+	this->deferredUnsubscribes->clear();
 }
 
-void MessageDispatcher::send(Message message) {
-	for (Receiver* receiver : this->receivers[message]) {
-		receiver->receive(message);
+// Counting sort of the posted events into dispatching. Stable, so events of one message keep their
+// posting order, and unlike std::stable_sort it needs no temporary buffer
+void MessageDispatcher::groupByMessage() {
+	int offsets[Message::COUNT] = {};
+	int position = 0;
+
+	for (const Event& event : *this->posted) {
+		offsets[event.message]++;
+	}
+
+	for (int message = 0; message < Message::COUNT; message++) {
+		int count = offsets[message];
+		offsets[message] = position;
+		position += count;
+	}
+
+	this->dispatching->resize(this->posted->size());
+
+	for (const Event& event : *this->posted) {
+		(*this->dispatching)[offsets[event.message]++] = event;
 	}
+
+	this->posted->clear();
 }
 
+// Drops every subscription, invalidating all outstanding handles, while keeping the storage around.
+// Events other threads have queued survive, since their producers may outlive the level
 void MessageDispatcher::clear() {
-	delete[] this->receivers;
-	this->receivers = new std::vector<Receiver*>[Message::COUNT]();
+	for (int message = 0; message < Message::COUNT; message++) {
+		this->subscribers[message].clear();
+	}
+
+	this->freeSlots->clear();
+
+	for (Uint32 slot = 0; slot < this->slots->size(); slot++) {
+		SubscriptionSlot& entry = (*this->slots)[slot];
+
+		entry.receiver = nullptr;
+		entry.position = -1;
+		entry.generation++;
+		this->freeSlots->push_back(slot);
+	}
+
+	this->deferredUnsubscribes->clear();
+	this->pending->clear();
+}
+
+FanOutStats MessageDispatcher::getFanOutStats(Message message) {
+	return this->stats[message];
+}
+
+void MessageDispatcher::resetFanOutStats() {
+	for (int message = 0; message < Message::COUNT; message++) {
+		this->stats[message] = { 0, 0 };
+	}
+}
+
+void MessageDispatcher::printFanOutStats() {
+	printf("%-28s %10s %12s %8s\n", "message", "events", "deliveries", "fan-out");
+
+	for (int message = 0; message < Message::COUNT; message++) {
+		FanOutStats& stats = this->stats[message];
+
+		if (stats.events > 0) {
+			printf("%-28s %10ld %12ld %8.2f\n", MESSAGE_NAMES[message], stats.events, stats.deliveries, (double) stats.deliveries / stats.events);
+		}
+	}
+
+	printf("cross-thread queue: max depth %d/%d, dropped %ld\n", this->maxQueueDepth, this->queued->getCapacity(), this->queued->getDropped());
+}
+
+const char* MessageDispatcher::getMessageName(Message message) {
+	return MESSAGE_NAMES[message];
+}
+
+int MessageDispatcher::getQueueDepth() {
+	return this->queued->getDepth();
+}
+
+int MessageDispatcher::getMaxQueueDepth() {
+	return this->maxQueueDepth;
+}
+
+long MessageDispatcher::getQueueDropped() {
+	return this->queued->getDropped();
 }
 
 MessageDispatcher::~MessageDispatcher() {
-	delete[] this->receivers;
-}
\ No newline at end of file
+	delete[] this->subscribers;
+	delete this->slots;
+	delete this->freeSlots;
+	delete this->deferredUnsubscribes;
+	delete this->pending;
+	delete this->posted;
+	delete this->dispatching;
+	delete this->queued;
+}
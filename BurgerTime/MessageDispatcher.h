@@ -1,8 +1,11 @@
 #pragma once
 #include <vector>
+#include "SDL.h"
 #include "Receiver.h"
 
 class Receiver;
+class Entity;
+class EventQueue;
 enum Message { NULL_MESSAGE, EXIT, MOVE_LEFT, MOVE_RIGHT, MOVE_UP, MOVE_DOWN, MAIN_ACTION, SWITCH_NIGHT_MODE, RESET_GAME, LOAD_NEW_LEVEL,
 	ON_FLOOR, NEAR_FLOOR, ON_INGREDIENT_1, ON_INGREDIENT_2, ON_INGREDIENT_3, ON_INGREDIENT_4, INGREDIENT_ON_FLOOR, INGREDIENT_INGREDIENT_HIT,
 	INTERSECT_LIMIT_LEFT, INTERSECT_LIMIT_RIGHT, INTERSECT_STAIRS, INTERSECT_UP_STAIRS, INTERSECT_DOWN_STAIRS, INTERSECT_RELOAD_PEPPER,
@@ -10,16 +13,83 @@ enum Message { NULL_MESSAGE, EXIT, MOVE_LEFT, MOVE_RIGHT, MOVE_UP, MOVE_DOWN, MA
 	INGREDIENT_FLOOR_HIT, INGREDIENT_FINISHED, PLAYER_DIED, GAME_STARTED, GAME_VICTORY, GAME_OVER,
 	COUNT };
 
+const int MAX_DISPATCH_ROUNDS = 8;
+const int INITIAL_EVENT_CAPACITY = 256;
+
+// An event with a target is delivered to that receiver only, whether or not it subscribed
+struct Event {
+	Message message;
+	Entity* sender;
+	Receiver* target;
+	double x;
+	double y;
+	int value;
+};
+
+// Handle returned by subscribe. It goes stale when unsubscribed or when the dispatcher is cleared
+struct Subscription {
+	Uint32 slot;
+	Uint32 generation;
+};
+
+struct SubscriptionSlot {
+	Receiver* receiver;
+	Message message;
+	Uint32 generation;
+	int position;
+};
+
+struct Subscriber {
+	Receiver* receiver;
+	Uint32 slot;
+};
+
+struct FanOutStats {
+	long events;
+	long deliveries;
+};
+
 class MessageDispatcher {
-	std::vector<Receiver*>* receivers;
+	std::vector<Subscriber>* subscribers;
+	std::vector<SubscriptionSlot>* slots;
+	std::vector<Uint32>* freeSlots;
+	std::vector<Subscription>* deferredUnsubscribes;
+	std::vector<Event>* pending;
+	std::vector<Event>* posted;
+	std::vector<Event>* dispatching;
+	EventQueue* queued;
+	int maxQueueDepth;
+	FanOutStats stats[Message::COUNT];
+	bool delivering;
 
 public:
 	MessageDispatcher();
 	
-	void subscribe(Message message, Receiver* receiver);
-	void send(Message message);
+	Subscription subscribe(Message message, Receiver* receiver);
+	void unsubscribe(Subscription subscription);
+	bool isSubscribed(Subscription subscription);
+
+	void post(Message message);
+	void post(Message message, Entity* sender, int value = 0);
+	void post(Event event);
+	void postTo(Receiver* target, Message message, Entity* sender = nullptr, int value = 0);
+	void sendTo(Receiver* target, Message message);
+	bool postFromThread(Message message, int value = 0);
+	int drainQueued();
+	void dispatch();
 	void clear();
 
+	FanOutStats getFanOutStats(Message message);
+	void resetFanOutStats();
+	void printFanOutStats();
+	static const char* getMessageName(Message message);
+	int getQueueDepth();
+	int getMaxQueueDepth();
+	long getQueueDropped();
+
 	~MessageDispatcher();
-};
 
+private:
+	void removeSubscriber(Uint32 slot);
+	void groupByMessage();
+};
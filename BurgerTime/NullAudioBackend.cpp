@@ -0,0 +1,17 @@
+#include "NullAudioBackend.h"
+
+Mix_Music* NullAudioBackend::loadMusic(const char* path) {
+	return nullptr;
+}
+
+Mix_Chunk* NullAudioBackend::loadEffect(const char* path) {
+	return nullptr;
+}
+
+void NullAudioBackend::freeMusic(Mix_Music* music) { }
+void NullAudioBackend::freeEffect(Mix_Chunk* effect) { }
+void NullAudioBackend::playMusic(Mix_Music* music) { }
+void NullAudioBackend::pauseMusic() { }
+void NullAudioBackend::resumeMusic() { }
+void NullAudioBackend::rewindMusic() { }
+void NullAudioBackend::playEffect(Mix_Chunk* effect) { }
@@ -0,0 +1,16 @@
+#pragma once
+#include "AudioBackend.h"
+
+class NullAudioBackend : public AudioBackend {
+public:
+	virtual Mix_Music* loadMusic(const char* path);
+	virtual Mix_Chunk* loadEffect(const char* path);
+	virtual void freeMusic(Mix_Music* music);
+	virtual void freeEffect(Mix_Chunk* effect);
+
+	virtual void playMusic(Mix_Music* music);
+	virtual void pauseMusic();
+	virtual void resumeMusic();
+	virtual void rewindMusic();
+	virtual void playEffect(Mix_Chunk* effect);
+};
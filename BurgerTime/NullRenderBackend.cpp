@@ -0,0 +1,36 @@
+#include "NullRenderBackend.h"
+
+SDL_Texture* NullRenderBackend::loadTexture(const char* bmpPath) {
+	return nullptr;
+}
+
+void NullRenderBackend::getTextureSize(SDL_Texture* texture, int* width, int* height) {
+	*width = 0;
+	*height = 0;
+}
+
+void NullRenderBackend::destroyTexture(SDL_Texture* texture) { }
+
+TTF_Font* NullRenderBackend::openFont(const char* fontPath, int fontSize) {
+	return nullptr;
+}
+
+void NullRenderBackend::closeFont(TTF_Font* font) { }
+void NullRenderBackend::clear() { }
+
+void NullRenderBackend::drawTexture(SDL_Texture* texture, SDL_Rect* destination) {
+	this->drawCalls++;
+}
+
+void NullRenderBackend::drawText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale) {
+	this->drawCalls++;
+}
+
+void NullRenderBackend::fillRect(SDL_Rect* destination, SDL_Color color) {
+	this->drawCalls++;
+}
+
+void NullRenderBackend::present() {
+	this->lastFrameDrawCalls = this->drawCalls;
+	this->drawCalls = 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "RenderBackend.h"
+
+class NullRenderBackend : public RenderBackend {
+public:
+	virtual SDL_Texture* loadTexture(const char* bmpPath);
+	virtual void getTextureSize(SDL_Texture* texture, int* width, int* height);
+	virtual void destroyTexture(SDL_Texture* texture);
+
+	virtual TTF_Font* openFont(const char* fontPath, int fontSize);
+	virtual void closeFont(TTF_Font* font);
+
+	virtual void clear();
+	virtual void drawTexture(SDL_Texture* texture, SDL_Rect* destination);
+	virtual void drawText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale);
+	virtual void fillRect(SDL_Rect* destination, SDL_Color color);
+	virtual void present();
+};
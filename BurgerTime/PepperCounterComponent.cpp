@@ -1,4 +1,5 @@
 #include "PepperCounterComponent.h"
+#include <cstdio>
 
 PepperCounterComponent::PepperCounterComponent(Engine* engine, Entity* entity, Game* game) : Component(engine, entity) {
 	this->header = new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 8);
@@ -6,13 +7,15 @@ PepperCounterComponent::PepperCounterComponent(Engine* engine, Entity* entity, G
 	this->game = game;
 }
 
-void PepperCounterComponent::update(double dt) {
-	Coordinate* headerPos = this->entity->getPosition();
-	Coordinate* pepperPos = new Coordinate(headerPos->getX() + 2, headerPos->getY() + 8);
-	std::string score = std::to_string(this->game->getPepper());
+void PepperCounterComponent::render(double alpha) {
+	Coordinate headerPos = this->entity->getPosition();
+	Coordinate pepperPos(headerPos.getX() + 2, headerPos.getY() + 8);
+	char value[16];
 
-	this->header->draw(headerPos, "PEPPER", 0, 255, 0);
-	this->pepper->draw(pepperPos, score.c_str());
+	snprintf(value, sizeof(value), "%d", this->game->getPepper());
+
+	this->header->draw(&headerPos, "PEPPER", 0, 255, 0);
+	this->pepper->draw(&pepperPos, value);
 }
 
 PepperCounterComponent::~PepperCounterComponent() {
@@ -11,7 +11,7 @@ class PepperCounterComponent : public Component {
 public:
 	PepperCounterComponent(Engine* engine, Entity* entity, Game* game);
 
-	virtual void update(double dt);
+	virtual void render(double alpha);
 
 	~PepperCounterComponent();
 };
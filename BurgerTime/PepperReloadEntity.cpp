@@ -3,20 +3,19 @@
 #include "BoxCollideComponent.h"
 
 PepperReloadEntity::PepperReloadEntity(Engine* engine, Entity* player, std::vector<Entity*>* stairs) : Entity(engine) {
-	std::vector<Entity*>* playerWrapper = new std::vector<Entity*>();
-	
 	this->stairs = stairs;
+	this->playerList = new std::vector<Entity*>();
 
 	this->iceCream = new Sprite(engine->getRenderer(), "resources/sprites/ice_cream.bmp");
 	this->fries = new Sprite(engine->getRenderer(), "resources/sprites/fries.bmp");
 	this->render = new RenderComponent(engine, this, this->iceCream);
 
-	playerWrapper->push_back(player);
+	this->playerList->push_back(player);
 
 	this->addComponent(this->render);
-	this->addComponent(new BoxCollideComponent(engine, this, INTERSECT_RELOAD_PEPPER, playerWrapper));
+	this->addComponent(new BoxCollideComponent(engine, this, INTERSECT_RELOAD_PEPPER, this->playerList));
 
-	this->setBoundingBox(new BoundingBox(new Coordinate(16, 16)));
+	this->setBoundingBox(16, 16);
 	
 	this->hide();
 }
@@ -34,19 +33,25 @@ void PepperReloadEntity::update(double dt) {
 
 	if (this->hasReceived(INTERSECT_RELOAD_PEPPER)) {
 		this->hide();
-		this->engine->getMessageDispatcher()->send(INCREASE_PEPPER);
+		this->engine->getMessageDispatcher()->post(INCREASE_PEPPER, this);
+	}
+
+	if (!this->getEnabled()) {
+		this->sleepUntilSpawn(dt);
 	}
 
 	this->clearMessages();
 }
 
 void PepperReloadEntity::show() {
-	Entity* stair = this->stairs->at(rand() % this->stairs->size());
+	Entity* stair = this->stairs->at(this->engine->getRandom()->nextInt((int)this->stairs->size()));
 
-	this->setPosition(*stair->getPosition());
+	Coordinate stairPosition = stair->getPosition();
+	this->setPosition(stairPosition);
+	this->savePreviousPosition();
 	this->setEnabled(true);
 
-	if (rand() % 2 == 0) {
+	if (this->engine->getRandom()->nextInt(2) == 0) {
 		this->render->setSprite(this->iceCream);
 	}
 	else {
@@ -54,7 +59,23 @@ void PepperReloadEntity::show() {
 	}
 }
 
+// Like a hidden enemy, the countdown is run ahead and the reload sleeps until the tick it shows on
+void PepperReloadEntity::sleepUntilSpawn(double dt) {
+	int ticks = 0;
+
+	while (this->timeTillSpawn - dt > 0) {
+		this->timeTillSpawn -= dt;
+		ticks++;
+	}
+
+	this->sleepFor(ticks);
+}
+
 void PepperReloadEntity::hide() {
 	this->setEnabled(false);
-	this->timeTillSpawn = rand() % 30 + 30;
-}
\ No newline at end of file
+	this->timeTillSpawn = this->engine->getRandom()->nextInt(30) + 30;
+}
+
+PepperReloadEntity::~PepperReloadEntity() {
+	delete this->playerList;
+}
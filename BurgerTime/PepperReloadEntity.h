@@ -9,6 +9,7 @@ class PepperReloadEntity : 	public Entity {
 	RenderComponent* render;
 	
 	std::vector<Entity*>* stairs;
+	std::vector<Entity*>* playerList;
 	double timeTillSpawn;
 
 public:
@@ -16,8 +17,11 @@ public:
 
 	virtual void update(double dt);
 
+	~PepperReloadEntity();
+
 private:
 	void show();
 	void hide();
+	void sleepUntilSpawn(double dt);
 };
 
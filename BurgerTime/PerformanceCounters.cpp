@@ -0,0 +1,27 @@
+#include "PerformanceCounters.h"
+#include <cstdlib>
+#include <new>
+
+thread_local long PerformanceCounters::allocations = 0;
+thread_local long PerformanceCounters::collisionTests = 0;
+
+void* operator new(size_t size) {
+	void* memory = malloc(size > 0 ? size : 1);
+
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	PerformanceCounters::allocations++;
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+
+// Sized deletes would otherwise go to the library's delete, which must not free our malloc'd memory
+void operator delete(void* memory, size_t size) noexcept {
+	operator delete(memory);
+}
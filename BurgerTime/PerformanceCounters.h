@@ -0,0 +1,8 @@
+#pragma once
+
+// Per-thread so parallel headless sessions never contend on a shared counter
+class PerformanceCounters {
+public:
+	static thread_local long allocations;
+	static thread_local long collisionTests;
+};
@@ -0,0 +1,95 @@
+#include "PerformanceOverlayComponent.h"
+#include "Engine.h"
+#include "Constants.h"
+
+PerformanceOverlayComponent::PerformanceOverlayComponent(Engine* engine, Entity* entity, Game* game, Text* text) : Component(engine, entity) {
+	this->game = game;
+	this->text = text;
+	this->refreshTime = 0;
+	this->ownDrawCalls = 0;
+
+	for (int i = 0; i < OVERLAY_LINES; i++) {
+		this->lines[i][0] = '\0';
+	}
+}
+
+void PerformanceOverlayComponent::animate(double dt) {
+	if (this->engine->isOverlayVisible()) {
+		this->refreshTime -= dt;
+
+		// Text is only reformatted a few times per second so the overlay stays cheap to draw
+		if (this->refreshTime <= 0) {
+			this->refreshLines();
+			this->refreshTime = OVERLAY_REFRESH_SECONDS;
+		}
+	}
+}
+
+void PerformanceOverlayComponent::render(double alpha) {
+	if (!this->engine->isOverlayVisible()) {
+		return;
+	}
+
+	RenderBackend* renderer = this->engine->getRenderer();
+	Coordinate position = this->entity->getPosition();
+	int x = (int)position.getX();
+	int y = (int)position.getY();
+	SDL_Rect background = { x * RESOLUTION_MULTIPLIER, y * RESOLUTION_MULTIPLIER,
+		128 * RESOLUTION_MULTIPLIER, (OVERLAY_LINES * 8 + OVERLAY_GRAPH_HEIGHT + 6) * RESOLUTION_MULTIPLIER };
+
+	renderer->fillRect(&background, { 0, 0, 0, 192 });
+
+	for (int i = 0; i < OVERLAY_LINES; i++) {
+		Coordinate linePosition(x + 2, y + 2 + i * 8);
+		this->text->draw(&linePosition, this->lines[i], 0, 255, 0);
+	}
+
+	this->renderGraph(x + 2, y + OVERLAY_LINES * 8 + 4);
+
+	this->ownDrawCalls = 2 + OVERLAY_LINES + OVERLAY_GRAPH_BARS;
+}
+
+void PerformanceOverlayComponent::refreshLines() {
+	FramePacer* pacer = this->engine->getFramePacer();
+	FrameStats* stats = this->engine->getFrameStats();
+
+	snprintf(this->lines[0], OVERLAY_LINE_LENGTH, "%d FPS  P99 %.1f MS", this->engine->getFrameRate(),
+		pacer->getFrameTimePercentile(99));
+	snprintf(this->lines[1], OVERLAY_LINE_LENGTH, "SIM %.2f  RENDER %.2f MS", stats->simulationTime * 1000,
+		stats->renderTime * 1000);
+	snprintf(this->lines[2], OVERLAY_LINE_LENGTH, "DRAWS %d  TESTS %ld", stats->drawCalls - this->ownDrawCalls,
+		stats->collisionTests);
+	snprintf(this->lines[3], OVERLAY_LINE_LENGTH, "ACTIVE %d/%d  ALLOCS %ld", this->game->getActiveEntityCount(),
+		this->game->getEntityCount(), stats->allocations);
+}
+
+// One bar per recent frame, scaled so the top of the graph is two ticks long
+void PerformanceOverlayComponent::renderGraph(int x, int y) {
+	RenderBackend* renderer = this->engine->getRenderer();
+	FramePacer* pacer = this->engine->getFramePacer();
+	double budget = 1.0 / SIMULATION_TICKS_PER_SECOND;
+	int budgetHeight = OVERLAY_GRAPH_HEIGHT * RESOLUTION_MULTIPLIER / 2;
+	int bottom = (y + OVERLAY_GRAPH_HEIGHT) * RESOLUTION_MULTIPLIER;
+
+	SDL_Rect budgetLine = { x * RESOLUTION_MULTIPLIER, bottom - budgetHeight, OVERLAY_GRAPH_BARS * 2 * RESOLUTION_MULTIPLIER, 1 };
+	renderer->fillRect(&budgetLine, { 255, 255, 255, 128 });
+
+	for (int i = 0; i < OVERLAY_GRAPH_BARS; i++) {
+		int age = OVERLAY_GRAPH_BARS - 1 - i;
+		double frameTime = age < pacer->getHistorySize() ? pacer->getFrameTime(age) : 0;
+		int height = (int)(frameTime / budget * budgetHeight);
+
+		if (height > OVERLAY_GRAPH_HEIGHT * RESOLUTION_MULTIPLIER) {
+			height = OVERLAY_GRAPH_HEIGHT * RESOLUTION_MULTIPLIER;
+		}
+
+		SDL_Rect bar = { (x + i * 2) * RESOLUTION_MULTIPLIER, bottom - height, 2 * RESOLUTION_MULTIPLIER - 1, height };
+		SDL_Color color = frameTime <= budget * 1.05 ? SDL_Color{ 0, 200, 0, 255 } : SDL_Color{ 220, 40, 40, 255 };
+
+		renderer->fillRect(&bar, color);
+	}
+}
+
+PerformanceOverlayComponent::~PerformanceOverlayComponent() {
+	delete this->text;
+}
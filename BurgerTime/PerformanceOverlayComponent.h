@@ -0,0 +1,30 @@
+#pragma once
+#include "Component.h"
+#include "Text.h"
+#include "Game.h"
+
+const int OVERLAY_LINES = 4;
+const int OVERLAY_LINE_LENGTH = 64;
+const int OVERLAY_GRAPH_BARS = 60;
+const int OVERLAY_GRAPH_HEIGHT = 24;
+const double OVERLAY_REFRESH_SECONDS = 0.25;
+
+class PerformanceOverlayComponent : public Component {
+	Game* game;
+	Text* text;
+	char lines[OVERLAY_LINES][OVERLAY_LINE_LENGTH];
+	double refreshTime;
+	int ownDrawCalls;
+
+public:
+	PerformanceOverlayComponent(Engine* engine, Entity* entity, Game* game, Text* text);
+
+	virtual void animate(double dt);
+	virtual void render(double alpha);
+
+	virtual ~PerformanceOverlayComponent();
+
+private:
+	void refreshLines();
+	void renderGraph(int x, int y);
+};
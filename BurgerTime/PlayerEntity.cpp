@@ -2,64 +2,88 @@
 #include "PlayerRenderComponent.h"
 #include "WalkingRigidBodyComponent.h"
 #include "EnemyPlayerCollideComponent.h"
-#include "FloorCollideComponent.h"
+#include "WalkCollideComponent.h"
+#include "IngredientStepComponent.h"
 #include "RenderComponent.h"
 #include "Engine.h"
 
-PlayerEntity::PlayerEntity(Engine* engine, Coordinate* position, std::vector<Entity*>* enemies, Game* game) : Entity(engine, position) {
+PlayerEntity::PlayerEntity(Engine* engine, Coordinate* position, SweepAndPrune* bodies, LevelGeometry* geometry, std::vector<Entity*>* ingredients, Game* game) : Entity(engine, position) {
 	this->game = game;
 	
-	PlayerRenderComponent* renderComponent = new PlayerRenderComponent(this->engine, this);
-	WalkingRigidBodyComponent* rigidBodyComponent = new WalkingRigidBodyComponent(this->engine, this, true);
+	this->fixedComponents.set(new PlayerRenderComponent(this->engine, this), new WalkingRigidBodyComponent<PlayerEntity>(this->engine, this),
+		new EnemyPlayerCollideComponent(this->engine, this, bodies), new WalkCollideComponent(this->engine, this, geometry, this),
+		new IngredientStepComponent(this->engine, this, ingredients));
 
-	this->addComponent(renderComponent);
-	this->addComponent(rigidBodyComponent);
-	this->addComponent(new EnemyPlayerCollideComponent(this->engine, this, enemies));
-
-	this->setBoundingBox(new BoundingBox(new Coordinate(16, 16)));
+	this->setBoundingBox(16, 16);
 	
-	this->action = NO_ACTION;
+	this->setAction(NO_ACTION);
 	this->lastDirection = WALK_LEFT;
+	this->deadTime = 0;
 	this->initialPosition = new Coordinate(position->getX(), position->getY());
 
 	this->createPepper();
 
-	this->engine->getMessageDispatcher()->subscribe(MOVE_LEFT, this);
-	this->engine->getMessageDispatcher()->subscribe(MOVE_RIGHT, this);
-	this->engine->getMessageDispatcher()->subscribe(MOVE_UP, this);
-	this->engine->getMessageDispatcher()->subscribe(MOVE_DOWN, this);
-	this->engine->getMessageDispatcher()->subscribe(MAIN_ACTION, this);
-	this->engine->getMessageDispatcher()->subscribe(GAME_VICTORY, this);
+	this->subscriptions = new std::vector<Subscription>();
+	this->subscribe(MOVE_LEFT);
+	this->subscribe(MOVE_RIGHT);
+	this->subscribe(MOVE_UP);
+	this->subscribe(MOVE_DOWN);
+	this->subscribe(MAIN_ACTION);
+	this->subscribe(GAME_VICTORY);
+}
+
+void PlayerEntity::subscribe(Message message) {
+	this->subscriptions->push_back(this->engine->getMessageDispatcher()->subscribe(message, this));
+}
+
+void PlayerEntity::initFixedComponents() {
+	this->fixedComponents.init();
+}
+
+// Timers run ahead of the components, the point in the tick where the render component used to drive them
+void PlayerEntity::updateFixedComponents(double dt, Profiler* profiler) {
+	this->updateTimers(dt);
+	this->fixedComponents.update(dt, profiler);
+}
+
+void PlayerEntity::animateFixedComponents(double dt) {
+	this->fixedComponents.animate(dt);
+}
+
+void PlayerEntity::renderFixedComponents(double alpha) {
+	this->fixedComponents.render(alpha);
 }
 
 void PlayerEntity::update(double dt) {
 	Entity::update(dt);
 
-	if (this->action != CELEBRATE_VICTORY && this->action != DIE) {
-		this->action = NO_ACTION;
+	if (this->getAction() != CELEBRATE_VICTORY && this->getAction() != DIE) {
+		this->setAction(NO_ACTION);
 
 		if (this->hasReceived(ON_FLOOR)) {
 			if (this->hasReceived(MOVE_LEFT) && !this->hasReceived(INTERSECT_LIMIT_LEFT)) {
-				this->action = this->lastDirection = WALK_LEFT;
+				this->lastDirection = WALK_LEFT;
+				this->setAction(WALK_LEFT);
 			}
 			else if (this->hasReceived(MOVE_RIGHT) && !this->hasReceived(INTERSECT_LIMIT_RIGHT)) {
-				this->action = this->lastDirection = WALK_RIGHT;
+				this->lastDirection = WALK_RIGHT;
+				this->setAction(WALK_RIGHT);
 			}
 		}
-		if (this->hasReceived(MOVE_UP) && this->hasReceived(INTERSECT_STAIRS) && !this->hasReceived(INTERSECT_UP_STAIRS)) {
-			this->action = GO_UPSTAIRS;
+		if (this->hasReceivedAll({ MOVE_UP, INTERSECT_STAIRS }) && !this->hasReceived(INTERSECT_UP_STAIRS)) {
+			this->setAction(GO_UPSTAIRS);
 		}
-		if (this->hasReceived(MOVE_DOWN) && this->hasReceived(INTERSECT_STAIRS) && !this->hasReceived(INTERSECT_DOWN_STAIRS)) {
-			this->action = GO_DOWNSTAIRS;
+		if (this->hasReceivedAll({ MOVE_DOWN, INTERSECT_STAIRS }) && !this->hasReceived(INTERSECT_DOWN_STAIRS)) {
+			this->setAction(GO_DOWNSTAIRS);
 		}
 		if (this->hasReceived(MAIN_ACTION)) {
 			this->throwPepper();
 		}
 		if (this->hasReceived(GAME_VICTORY)) {
-			this->action = CELEBRATE_VICTORY;
+			this->setAction(CELEBRATE_VICTORY);
 		}
 		if (this->hasReceived(ENEMY_ATTACK)) {
-			this->action = DIE;
+			this->setAction(DIE);
 		}
 	}
 
@@ -76,25 +100,46 @@ void PlayerEntity::update(double dt) {
 
 void PlayerEntity::setInitialPosition(Coordinate* position) {
 	this->setPosition(*position);
+	this->savePreviousPosition();
 	this->initialPosition->copyFrom(*position);
 }
 
 void PlayerEntity::respawn() {
-	this->action = NO_ACTION;
+	this->setAction(NO_ACTION);
 	this->setPosition(*this->initialPosition);
-}
-
-CharacterAction PlayerEntity::getAction() {
-	return this->action;
+	this->savePreviousPosition();
 }
 
 Entity* PlayerEntity::getPepper() {
 	return this->pepper;
 }
 
+std::vector<Entity*>* PlayerEntity::getPepperList() {
+	return this->pepperList;
+}
+
+double PlayerEntity::getDeadTime() {
+	return this->deadTime;
+}
+
 void PlayerEntity::notifyNearFloor(Entity* floor) {
-	if (this->hasReceived(MOVE_LEFT) || this->hasReceived(MOVE_RIGHT)) {
-		this->position->setY(floor->getPosition()->getY() - 8);
+	if (this->hasReceivedAny({ MOVE_LEFT, MOVE_RIGHT })) {
+		Coordinate position = Coordinate(this->getPosition().getX(), floor->getPosition().getY() - 8);
+		this->setPosition(position);
+	}
+}
+
+void PlayerEntity::updateTimers(double dt) {
+	if (this->getAction() != DIE) {
+		this->deadTime = 0;
+		return;
+	}
+
+	this->deadTime += dt;
+
+	// Announced once, the respawn only happens when the event is dispatched
+	if (this->deadTime * 1000 >= COOK_DIE_ANIMATION_MILLISECS * 16 && (this->deadTime - dt) * 1000 < COOK_DIE_ANIMATION_MILLISECS * 16) {
+		this->engine->getMessageDispatcher()->post(PLAYER_DIED, this);
 	}
 }
 
@@ -104,20 +149,28 @@ void PlayerEntity::createPepper() {
 
 	Sprite* pepperSprite = new Sprite(this->engine->getRenderer(), "resources/sprites/pepper (%d).bmp", 1, 4, PEPPER_ANIMATION_MILLISECS);
 
-	this->pepper->setBoundingBox(new BoundingBox(new Coordinate(16, 16)));
-	this->pepper->addComponent(new RenderComponent(this->engine, this->pepper, pepperSprite));
+	this->pepperRender = new RenderComponent(this->engine, this->pepper, pepperSprite);
+
+	this->pepper->setBoundingBox(16, 16);
+	this->pepper->addComponent(this->pepperRender);
+
+	this->pepperList = new std::vector<Entity*>();
+	this->pepperList->push_back(this->pepper);
 }
 
 void PlayerEntity::throwPepper() {
 	if (!this->pepperActive && this->game->getPepper() > 0) {
 		int pepperOffset = this->lastDirection == WALK_LEFT ? -16 : 16;
-		Coordinate pepperPos = Coordinate(this->position->getX() + pepperOffset, this->position->getY());
+		Coordinate position = this->getPosition();
+		Coordinate pepperPos = Coordinate(position.getX() + pepperOffset, position.getY());
 
-		((RenderComponent*)this->pepper->getComponent(0))->getSprite()->resetAnimation();
+		this->pepperRender->getSprite()->resetAnimation();
 		
 		this->pepper->setPosition(pepperPos);
+		this->pepper->savePreviousPosition();
+		this->pepper->setEnabled(true);
 		this->pepperActive = true;
-		this->engine->getMessageDispatcher()->send(PEPPER_THROWN);
+		this->engine->getMessageDispatcher()->post(PEPPER_THROWN, this);
 	}
 }
 
@@ -127,4 +180,15 @@ void PlayerEntity::hidePepper() {
 	this->pepperActive = false;
 	this->pepperActiveTime = 0;
 	this->pepper->setPosition(newPos);
+	this->pepper->savePreviousPosition();
+	this->pepper->setEnabled(false);
+}
+
+PlayerEntity::~PlayerEntity() {
+	for (Subscription subscription : *this->subscriptions) {
+		this->engine->getMessageDispatcher()->unsubscribe(subscription);
+	}
+
+	delete this->subscriptions;
+	delete this->pepperList;
 }
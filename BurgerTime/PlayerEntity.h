@@ -1,33 +1,63 @@
 #pragma once
 #include "Entity.h"
 #include "EnemyEntity.h"
+#include "ComponentSet.h"
+#include "SweepAndPrune.h"
+#include "LevelGeometry.h"
 
 class Game;
+class PlayerEntity;
+class PlayerRenderComponent;
+class EnemyPlayerCollideComponent;
+class WalkCollideComponent;
+class IngredientStepComponent;
+class RenderComponent;
+template <typename Owner> class WalkingRigidBodyComponent;
+
+typedef ComponentSet<PlayerRenderComponent, WalkingRigidBodyComponent<PlayerEntity>, EnemyPlayerCollideComponent, WalkCollideComponent,
+	IngredientStepComponent> PlayerComponents;
 
 class PlayerEntity : public Entity {
+	PlayerComponents fixedComponents;
 	Game* game;
 	Coordinate* initialPosition;
-	CharacterAction action;
 	CharacterAction lastDirection;
 	Entity* pepper;
+	std::vector<Entity*>* pepperList;
+	RenderComponent* pepperRender;
 	bool pepperActive;
 	double pepperActiveTime;
+	double deadTime;
+	std::vector<Subscription>* subscriptions;
 
 public:
-	PlayerEntity(Engine* engine, Coordinate* position, std::vector<Entity*>* enemies, Game* game);
+	static constexpr double WALKING_SPEED_PROPORTION = 1;
+
+	PlayerEntity(Engine* engine, Coordinate* position, SweepAndPrune* bodies, LevelGeometry* geometry, std::vector<Entity*>* ingredients, Game* game);
 
 	virtual void update(double dt);
 	void setInitialPosition(Coordinate* position);
 	void respawn();
 
-	CharacterAction getAction();
 	Entity* getPepper();
+	std::vector<Entity*>* getPepperList();
+	double getDeadTime();
 
 	void notifyNearFloor(Entity* floor);
 
+	~PlayerEntity();
+
+protected:
+	virtual void initFixedComponents();
+	virtual void updateFixedComponents(double dt, Profiler* profiler);
+	virtual void animateFixedComponents(double dt);
+	virtual void renderFixedComponents(double alpha);
+
 private:
+	void updateTimers(double dt);
 	void createPepper();
 	void throwPepper();
 	void hidePepper();
+	void subscribe(Message message);
 };
 
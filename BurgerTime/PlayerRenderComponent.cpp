@@ -2,7 +2,7 @@
 #include "PlayerEntity.h"
 #include "PlayerRenderComponent.h"
 
-PlayerRenderComponent::PlayerRenderComponent(Engine* engine, Entity* entity) : Component(engine, entity) {
+PlayerRenderComponent::PlayerRenderComponent(Engine* engine, PlayerEntity* player) : Component(engine, player) {
 	this->standingStill = new Sprite(this->engine->getRenderer(), "resources/sprites/cook_downstairs (2).bmp");
 	this->walkingLeft = new Sprite(this->engine->getRenderer(), "resources/sprites/cook_left (%d).bmp", 1, 3, WALKING_ANIMATION_MILLISECS);
 	this->walkingRight = new Sprite(this->engine->getRenderer(), "resources/sprites/cook_right (%d).bmp", 1, 3, WALKING_ANIMATION_MILLISECS);
@@ -12,13 +12,14 @@ PlayerRenderComponent::PlayerRenderComponent(Engine* engine, Entity* entity) : C
 	this->die1 = new Sprite(this->engine->getRenderer(), "resources/sprites/cook_die1 (%d).bmp", 1, 3, COOK_DIE_ANIMATION_MILLISECS);
 	this->die2 = new Sprite(this->engine->getRenderer(), "resources/sprites/cook_die2 (%d).bmp", 1, 2, COOK_DIE_ANIMATION_MILLISECS);
 
-	this->deadTime = 0;
+	this->currentSprite = this->standingStill;
+	this->player = player;
 }
 
-void PlayerRenderComponent::update(double dt) {
+void PlayerRenderComponent::animate(double dt) {
 	Sprite* sprite = nullptr;
 
-	switch (((PlayerEntity*)this->entity)->getAction()) {
+	switch (this->entity->getAction()) {
 		case WALK_LEFT:
 			sprite = this->walkingLeft;
 			break;
@@ -35,27 +36,21 @@ void PlayerRenderComponent::update(double dt) {
 			sprite = this->celebrate;
 			break;
 		case DIE:
-			sprite = this->die1;
-			this->deadTime += dt;
-
-			if (this->deadTime * 1000 >= COOK_DIE_ANIMATION_MILLISECS * 3) {
-				sprite = this->die2;
-
-				if (this->deadTime * 1000 >= COOK_DIE_ANIMATION_MILLISECS * 16) {
-					this->engine->getMessageDispatcher()->send(PLAYER_DIED);
-
-					if (((PlayerEntity*)this->entity)->getAction() == NO_ACTION) {
-						this->deadTime = 0;
-					}
-				}
-			}
+			sprite = this->player->getDeadTime() * 1000 >= COOK_DIE_ANIMATION_MILLISECS * 3 ? this->die2 : this->die1;
 			break;
 		default:
 			sprite = this->standingStill;
 			break;
 	}
 
-	sprite->draw((int)entity->getPosition()->getX(), (int)entity->getPosition()->getY(), dt);
+	sprite->update(dt);
+	this->currentSprite = sprite;
+}
+
+void PlayerRenderComponent::render(double alpha) {
+	Coordinate position = this->entity->getInterpolatedPosition(alpha);
+
+	this->currentSprite->draw((int)position.getX(), (int)position.getY());
 }
 
 PlayerRenderComponent::~PlayerRenderComponent() {
@@ -2,6 +2,8 @@
 #include "Component.h"
 #include "Sprite.h"
 
+class PlayerEntity;
+
 class PlayerRenderComponent : public Component {
 	Sprite* standingStill;
 	Sprite* walkingLeft;
@@ -11,13 +13,14 @@ class PlayerRenderComponent : public Component {
 	Sprite* celebrate;
 	Sprite* die1;
 	Sprite* die2;
-	
-	double deadTime;
+	Sprite* currentSprite;
+	PlayerEntity* player;
 
 public:
-	PlayerRenderComponent(Engine* engine, Entity* entity);
+	PlayerRenderComponent(Engine* engine, PlayerEntity* player);
 
-	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 
 	~PlayerRenderComponent();
 };
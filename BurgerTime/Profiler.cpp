@@ -0,0 +1,130 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include "Profiler.h"
+#include <cstdio>
+#include <cstring>
+
+Profiler::Profiler() {
+	this->frames = new std::vector<std::vector<ProfileEvent>>();
+	this->currentFrame = 0;
+	this->recordedFrames = 0;
+	this->enabled = false;
+	this->outputPath = new std::string("profile.json");
+	this->counterFrequency = (double)SDL_GetPerformanceFrequency();
+	this->origin = SDL_GetPerformanceCounter();
+}
+
+// The frame buffers are only allocated the first time capturing starts, most engines never profile
+void Profiler::setEnabled(bool enabled) {
+	if (enabled && this->frames->empty()) {
+		this->frames->resize(PROFILER_FRAMES);
+
+		for (std::vector<ProfileEvent>& frame : *this->frames) {
+			frame.reserve(PROFILER_EVENTS_PER_FRAME);
+		}
+	}
+
+	this->enabled = enabled;
+}
+
+void Profiler::setOutputPath(const char* path) {
+	delete this->outputPath;
+
+	this->outputPath = new std::string(path);
+}
+
+void Profiler::beginFrame() {
+	if (this->enabled) {
+		this->currentFrame = (this->currentFrame + 1) % PROFILER_FRAMES;
+		this->frames->at(this->currentFrame).clear();
+
+		if (this->recordedFrames < PROFILER_FRAMES) {
+			this->recordedFrames++;
+		}
+	}
+}
+
+void Profiler::record(const char* name, Uint64 start, Uint64 end) {
+	std::vector<ProfileEvent>& frame = this->frames->at(this->currentFrame);
+
+	// Never grow while capturing, a dropped event is cheaper than a reallocation
+	if (frame.size() < frame.capacity()) {
+		frame.push_back({ name, start, end });
+	}
+}
+
+void Profiler::addTotals(std::map<std::string, ProfileTotal>* totals) {
+	for (int i = 0; i < this->recordedFrames; i++) {
+		for (ProfileEvent& event : this->frames->at((this->currentFrame - i + PROFILER_FRAMES) % PROFILER_FRAMES)) {
+			ProfileTotal& total = (*totals)[event.name];
+
+			total.calls++;
+			total.counts += event.end - event.start;
+		}
+	}
+}
+
+void Profiler::reset() {
+	for (std::vector<ProfileEvent>& frame : *this->frames) {
+		frame.clear();
+	}
+
+	this->recordedFrames = 0;
+}
+
+double Profiler::countsToNanoseconds(Uint64 counts) {
+	return counts * 1000000000.0 / this->counterFrequency;
+}
+
+bool Profiler::dump() {
+	FILE* fp = fopen(this->outputPath->c_str(), "w");
+	std::map<std::string, ProfileTotal> totals;
+	bool first = true;
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	fprintf(fp, "{\"traceEvents\":[\n");
+
+	for (int i = this->recordedFrames - 1; i >= 0; i--) {
+		std::vector<ProfileEvent>& frame = this->frames->at((this->currentFrame - i + PROFILER_FRAMES) % PROFILER_FRAMES);
+
+		for (ProfileEvent& event : frame) {
+			double start = (event.start - this->origin) * 1000000.0 / this->counterFrequency;
+			double duration = (event.end - event.start) * 1000000.0 / this->counterFrequency;
+
+			fprintf(fp, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+				first ? "" : ",\n", event.name, start, duration);
+			first = false;
+		}
+	}
+
+	this->addTotals(&totals);
+
+	fprintf(fp, "\n],\"otherData\":{\"frames\":%d", this->recordedFrames);
+
+	for (auto& total : totals) {
+		fprintf(fp, ",\"%s\":\"%ld calls, %.3f ms\"", total.first.c_str(), total.second.calls,
+			total.second.counts * 1000.0 / this->counterFrequency);
+	}
+
+	fprintf(fp, "}}\n");
+	fclose(fp);
+
+	printf("%-40s %10s %12s %12s\n", "scope", "calls", "total ms", "ms/frame");
+
+	for (auto& total : totals) {
+		double milliseconds = total.second.counts * 1000.0 / this->counterFrequency;
+
+		printf("%-40s %10ld %12.3f %12.4f\n", total.first.c_str(), total.second.calls, milliseconds,
+			this->recordedFrames > 0 ? milliseconds / this->recordedFrames : 0);
+	}
+
+	return true;
+}
+
+Profiler::~Profiler() {
+	delete this->frames;
+	delete this->outputPath;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+const int PROFILER_FRAMES = 240;
+const int PROFILER_EVENTS_PER_FRAME = 4096;
+
+struct ProfileEvent {
+	const char* name;
+	Uint64 start;
+	Uint64 end;
+};
+
+struct ProfileTotal {
+	long calls;
+	Uint64 counts;
+};
+
+class Profiler {
+	std::vector<std::vector<ProfileEvent>>* frames;
+	int currentFrame;
+	int recordedFrames;
+	bool enabled;
+
+	std::string* outputPath;
+	double counterFrequency;
+	Uint64 origin;
+
+public:
+	Profiler();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() { return this->enabled; }
+	void setOutputPath(const char* path);
+
+	void beginFrame();
+	void record(const char* name, Uint64 start, Uint64 end);
+	void addTotals(std::map<std::string, ProfileTotal>* totals);
+	void reset();
+	double countsToNanoseconds(Uint64 counts);
+	bool dump();
+
+	~Profiler();
+};
+
+class ProfileScope {
+	Profiler* profiler;
+	const char* name;
+	Uint64 start;
+
+public:
+	// Inline so a disabled profiler costs a single branch per scope
+	ProfileScope(Profiler* profiler, const char* name) {
+		this->profiler = profiler->isEnabled() ? profiler : nullptr;
+		this->name = name;
+		this->start = this->profiler != nullptr ? SDL_GetPerformanceCounter() : 0;
+	}
+
+	~ProfileScope() {
+		if (this->profiler != nullptr) {
+			this->profiler->record(this->name, this->start, SDL_GetPerformanceCounter());
+		}
+	}
+};
@@ -0,0 +1,23 @@
+#include "Random.h"
+
+Random::Random(Uint64 seed) {
+	this->setSeed(seed);
+}
+
+void Random::setSeed(Uint64 seed) {
+	this->state = seed;
+}
+
+// splitmix64: tiny state, so every Engine can carry its own generator
+Uint64 Random::next() {
+	Uint64 z = (this->state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return z ^ (z >> 31);
+}
+
+int Random::nextInt(int bound) {
+	return (int)(this->next() % (Uint64)bound);
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "SDL.h"
+
+class Random {
+	Uint64 state;
+
+public:
+	Random(Uint64 seed);
+
+	void setSeed(Uint64 seed);
+	Uint64 next();
+	int nextInt(int bound);
+};
@@ -1,21 +1,43 @@
 #include "Receiver.h"
 
+static_assert(Message::COUNT <= 64, "Receiver keeps one bit per message in a 64-bit mask");
+
 Receiver::Receiver() {
-	this->receivedMessages = new std::unordered_set<Message>();
+	this->receivedMessages = 0;
 }
 
 void Receiver::receive(Message message) {
-	this->receivedMessages->insert(message);
+	this->receivedMessages |= (Uint64)1 << message;
+}
+
+void Receiver::receive(const Event& event) {
+	this->receive(event.message);
 }
 
 bool Receiver::hasReceived(Message message) {
-	return this->receivedMessages->count(message) > 0;
+	return (this->receivedMessages & ((Uint64)1 << message)) != 0;
+}
+
+bool Receiver::hasReceivedAll(std::initializer_list<Message> messages) {
+	Uint64 mask = maskOf(messages);
+
+	return (this->receivedMessages & mask) == mask;
+}
+
+bool Receiver::hasReceivedAny(std::initializer_list<Message> messages) {
+	return (this->receivedMessages & maskOf(messages)) != 0;
 }
 
 void Receiver::clearMessages() {
-	this->receivedMessages->clear();
+	this->receivedMessages = 0;
 }
 
-Receiver::~Receiver() {
-	delete this->receivedMessages;
+Uint64 Receiver::maskOf(std::initializer_list<Message> messages) {
+	Uint64 mask = 0;
+
+	for (Message message : messages) {
+		mask |= (Uint64)1 << message;
+	}
+
+	return mask;
 }
@@ -1,19 +1,26 @@
 #pragma once
 #include "MessageDispatcher.h"
-#include <unordered_set>
+#include <initializer_list>
+#include "SDL.h"
+#include "ArenaObject.h"
 
 enum Message;
+struct Event;
 
-class Receiver {
-	std::unordered_set<Message>* receivedMessages;
+class Receiver : public ArenaObject {
+	Uint64 receivedMessages;
 
 public:
 	Receiver();
 
 	virtual void receive(Message message);
+	virtual void receive(const Event& event);
 
 	bool hasReceived(Message message);
+	bool hasReceivedAll(std::initializer_list<Message> messages);
+	bool hasReceivedAny(std::initializer_list<Message> messages);
 	void clearMessages();
 
-	~Receiver();
-};
\ No newline at end of file
+private:
+	static Uint64 maskOf(std::initializer_list<Message> messages);
+};
@@ -0,0 +1,12 @@
+#include "RenderBackend.h"
+
+RenderBackend::RenderBackend() {
+	this->drawCalls = 0;
+	this->lastFrameDrawCalls = 0;
+}
+
+int RenderBackend::getDrawCalls() {
+	return this->lastFrameDrawCalls;
+}
+
+RenderBackend::~RenderBackend() { }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include "SDL.h"
+#include "SDL_ttf.h"
+
+class RenderBackend {
+protected:
+	int drawCalls;
+	int lastFrameDrawCalls;
+
+public:
+	RenderBackend();
+
+	virtual SDL_Texture* loadTexture(const char* bmpPath) = 0;
+	virtual void getTextureSize(SDL_Texture* texture, int* width, int* height) = 0;
+	virtual void destroyTexture(SDL_Texture* texture) = 0;
+
+	virtual TTF_Font* openFont(const char* fontPath, int fontSize) = 0;
+	virtual void closeFont(TTF_Font* font) = 0;
+
+	virtual void clear() = 0;
+	virtual void drawTexture(SDL_Texture* texture, SDL_Rect* destination) = 0;
+	virtual void drawText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale) = 0;
+	virtual void fillRect(SDL_Rect* destination, SDL_Color color) = 0;
+	virtual void present() = 0;
+
+	int getDrawCalls();
+
+	virtual ~RenderBackend();
+};
@@ -7,9 +7,14 @@ RenderComponent::RenderComponent(Engine * engine, Entity * entity, Sprite * spri
 	this->offset = offset;
 }
 
-void RenderComponent::update(double dt) {
-	this->sprite->draw((int)entity->getPosition()->getX() + (int)offset->getX(),
-		(int)entity->getPosition()->getY() + (int)offset->getY(), dt);
+void RenderComponent::animate(double dt) {
+	this->sprite->update(dt);
+}
+
+void RenderComponent::render(double alpha) {
+	Coordinate position = this->entity->getInterpolatedPosition(alpha);
+
+	this->sprite->draw((int)position.getX() + (int)offset->getX(), (int)position.getY() + (int)offset->getY());
 }
 
 Sprite* RenderComponent::getSprite() {
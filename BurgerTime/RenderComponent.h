@@ -10,7 +10,8 @@ public:
 	RenderComponent(Engine* engine, Entity* entity, Sprite* sprite);
 	RenderComponent(Engine* engine, Entity* entity, Sprite* sprite, Coordinate* offset);
 
-	virtual void update(double dt);
+	virtual void animate(double dt);
+	virtual void render(double alpha);
 	Sprite* getSprite();
 	void setSprite(Sprite* sprite);
 
@@ -1,14 +1,8 @@
 #include "RigidBodyComponent.h"
 
-RigidBodyComponent::RigidBodyComponent(Engine * engine, Entity * entity) : Component(engine, entity) {
-	this->velocity = new Coordinate();
-}
+RigidBodyComponent::RigidBodyComponent(Engine * engine, Entity * entity) : Component(engine, entity) { }
 
 void RigidBodyComponent::update(double dt) {
-	Coordinate newPosition = *entity->getPosition() + *this->velocity * dt;
+	Coordinate newPosition = entity->getPosition() + entity->getVelocity() * dt;
 	entity->setPosition(newPosition);
 }
-
-RigidBodyComponent::~RigidBodyComponent() {
-	delete this->velocity;
-}
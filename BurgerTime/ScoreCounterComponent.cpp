@@ -1,4 +1,5 @@
 #include "ScoreCounterComponent.h"
+#include <cstdio>
 
 ScoreCounterComponent::ScoreCounterComponent(Engine* engine, Entity* entity, Game* game) : Component(engine, entity) {
 	this->header = new Text(this->engine->getRenderer(), "resources/fonts/space_invaders.ttf", 8);
@@ -6,13 +7,15 @@ ScoreCounterComponent::ScoreCounterComponent(Engine* engine, Entity* entity, Gam
 	this->game = game;
 }
 
-void ScoreCounterComponent::update(double dt) {
-	Coordinate* headerPos = this->entity->getPosition();
-	Coordinate* scorePos = new Coordinate(headerPos->getX() + 2, headerPos->getY() + 8);
-	std::string score = std::to_string(this->game->getScore());
+void ScoreCounterComponent::render(double alpha) {
+	Coordinate headerPos = this->entity->getPosition();
+	Coordinate scorePos(headerPos.getX() + 2, headerPos.getY() + 8);
+	char value[16];
 
-	this->header->draw(headerPos, "1UP", 255, 0, 0);
-	this->score->draw(scorePos, score.c_str());
+	snprintf(value, sizeof(value), "%d", this->game->getScore());
+
+	this->header->draw(&headerPos, "1UP", 255, 0, 0);
+	this->score->draw(&scorePos, value);
 }
 
 ScoreCounterComponent::~ScoreCounterComponent() {
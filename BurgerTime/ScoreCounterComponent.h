@@ -11,7 +11,7 @@ class ScoreCounterComponent : public Component {
 public:
 	ScoreCounterComponent(Engine* engine, Entity* entity, Game* game);
 
-	virtual void update(double dt);
+	virtual void render(double alpha);
 
 	~ScoreCounterComponent();
 };
@@ -0,0 +1,37 @@
+#include "SdlAudioBackend.h"
+
+Mix_Music* SdlAudioBackend::loadMusic(const char* path) {
+	return Mix_LoadMUS(path);
+}
+
+Mix_Chunk* SdlAudioBackend::loadEffect(const char* path) {
+	return Mix_LoadWAV(path);
+}
+
+void SdlAudioBackend::freeMusic(Mix_Music* music) {
+	Mix_FreeMusic(music);
+}
+
+void SdlAudioBackend::freeEffect(Mix_Chunk* effect) {
+	Mix_FreeChunk(effect);
+}
+
+void SdlAudioBackend::playMusic(Mix_Music* music) {
+	Mix_PlayMusic(music, -1);
+}
+
+void SdlAudioBackend::pauseMusic() {
+	Mix_PauseMusic();
+}
+
+void SdlAudioBackend::resumeMusic() {
+	Mix_ResumeMusic();
+}
+
+void SdlAudioBackend::rewindMusic() {
+	Mix_RewindMusic();
+}
+
+void SdlAudioBackend::playEffect(Mix_Chunk* effect) {
+	Mix_PlayChannel(-1, effect, 0);
+}
@@ -0,0 +1,232 @@
+#include "SdlRenderBackend.h"
+
+SdlRenderBackend::SdlRenderBackend(const char* title, int width, int height) {
+	this->window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, 0);
+	this->renderer = nullptr;
+
+	this->building = new DrawList();
+	this->submitting = new DrawList();
+
+	this->jobPending = false;
+	this->framePending = false;
+	this->quit = false;
+
+	this->textCache = new std::unordered_map<std::string, CachedText>();
+	this->textKey = new std::string();
+	this->submittedFrames = 0;
+
+	this->renderThread = new std::thread(&SdlRenderBackend::renderLoop, this);
+
+	// The renderer belongs to the render thread, wait until it exists
+	this->runOnRenderThread([] {});
+}
+
+SDL_Texture* SdlRenderBackend::loadTexture(const char* bmpPath) {
+	SDL_Surface* surface = SDL_LoadBMP(bmpPath);
+	SDL_Texture* texture = nullptr;
+
+	this->runOnRenderThread([this, surface, &texture] {
+		texture = SDL_CreateTextureFromSurface(this->renderer, surface);
+	});
+
+	SDL_FreeSurface(surface);
+
+	return texture;
+}
+
+void SdlRenderBackend::getTextureSize(SDL_Texture* texture, int* width, int* height) {
+	SDL_QueryTexture(texture, nullptr, nullptr, width, height);
+}
+
+void SdlRenderBackend::destroyTexture(SDL_Texture* texture) {
+	this->runOnRenderThread([texture] {
+		SDL_DestroyTexture(texture);
+	});
+}
+
+TTF_Font* SdlRenderBackend::openFont(const char* fontPath, int fontSize) {
+	return TTF_OpenFont(fontPath, fontSize);
+}
+
+void SdlRenderBackend::closeFont(TTF_Font* font) {
+	this->runOnRenderThread([this, font] {
+		this->evictText(font, this->submittedFrames + 1);
+		TTF_CloseFont(font);
+	});
+}
+
+void SdlRenderBackend::clear() {
+	this->building->clear();
+}
+
+void SdlRenderBackend::drawTexture(SDL_Texture* texture, SDL_Rect* destination) {
+	this->building->addTexture(texture, destination, DRAW_LAYER_WORLD);
+	this->drawCalls++;
+}
+
+void SdlRenderBackend::drawText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale) {
+	this->building->addText(font, message, color, x, y, scale, DRAW_LAYER_HUD);
+	this->drawCalls++;
+}
+
+void SdlRenderBackend::fillRect(SDL_Rect* destination, SDL_Color color) {
+	this->building->addRect(destination, color, DRAW_LAYER_HUD);
+	this->drawCalls++;
+}
+
+void SdlRenderBackend::present() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	// Keep at most one frame in flight so simulation never runs away from the screen
+	this->signal.wait(lock, [this] { return !this->framePending; });
+
+	DrawList* ready = this->building;
+	this->building = this->submitting;
+	this->submitting = ready;
+
+	this->framePending = true;
+	this->signal.notify_all();
+
+	lock.unlock();
+
+	this->lastFrameDrawCalls = this->drawCalls;
+	this->drawCalls = 0;
+
+	this->building->clear();
+}
+
+void SdlRenderBackend::renderLoop() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	this->renderer = SDL_CreateRenderer(this->window, -1, 0);
+
+	SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
+
+	while (true) {
+		this->signal.wait(lock, [this] { return this->quit || this->jobPending || this->framePending; });
+
+		if (this->jobPending) {
+			this->job();
+			this->jobPending = false;
+			this->signal.notify_all();
+		}
+		else if (this->framePending) {
+			lock.unlock();
+			this->submit(this->submitting);
+			lock.lock();
+
+			this->framePending = false;
+			this->signal.notify_all();
+		}
+		else if (this->quit) {
+			break;
+		}
+	}
+
+	this->evictText(nullptr, this->submittedFrames + 1);
+
+	SDL_DestroyRenderer(this->renderer);
+}
+
+void SdlRenderBackend::submit(DrawList* drawList) {
+	drawList->sortByLayer();
+
+	SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 255);
+	SDL_RenderClear(this->renderer);
+
+	for (DrawCommand& command : *drawList->getCommands()) {
+		if (command.type == DRAW_TEXTURE) {
+			SDL_RenderCopy(this->renderer, command.texture, nullptr, &command.rect);
+		}
+		else if (command.type == DRAW_TEXT) {
+			CachedText* text = this->getCachedText(command);
+			SDL_Rect dstrect = { command.rect.x, command.rect.y, text->width * command.scale, text->height * command.scale };
+
+			SDL_RenderCopy(this->renderer, text->texture, nullptr, &dstrect);
+		}
+		else {
+			SDL_SetRenderDrawColor(this->renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+			SDL_RenderFillRect(this->renderer, &command.rect);
+		}
+	}
+
+	SDL_RenderPresent(this->renderer);
+
+	this->submittedFrames++;
+
+	if (this->submittedFrames % TEXT_CACHE_LIFETIME_FRAMES == 0) {
+		this->evictText(nullptr, this->submittedFrames - TEXT_CACHE_LIFETIME_FRAMES);
+	}
+}
+
+// Most text is identical from frame to frame, so rasterize each string once and reuse the texture
+CachedText* SdlRenderBackend::getCachedText(DrawCommand& command) {
+	char key[DRAW_TEXT_LENGTH + 32];
+	snprintf(key, sizeof(key), "%p %02x%02x%02x %s", (void*)command.font, command.color.r, command.color.g, command.color.b, command.text);
+
+	// Lookups reuse one key string instead of building a temporary that outgrows the small string buffer
+	this->textKey->assign(key);
+
+	auto found = this->textCache->find(*this->textKey);
+
+	if (found == this->textCache->end()) {
+		SDL_Surface* surface = TTF_RenderText_Solid(command.font, command.text, command.color);
+		CachedText text = { command.font, SDL_CreateTextureFromSurface(this->renderer, surface), 0, 0, 0 };
+
+		SDL_QueryTexture(text.texture, nullptr, nullptr, &text.width, &text.height);
+		SDL_FreeSurface(surface);
+
+		found = this->textCache->emplace(*this->textKey, text).first;
+	}
+
+	found->second.lastUsedFrame = this->submittedFrames;
+
+	return &found->second;
+}
+
+void SdlRenderBackend::evictText(TTF_Font* font, long unusedSince) {
+	for (auto it = this->textCache->begin(); it != this->textCache->end();) {
+		bool evict = font != nullptr ? it->second.font == font : it->second.lastUsedFrame < unusedSince;
+
+		if (evict) {
+			SDL_DestroyTexture(it->second.texture);
+			it = this->textCache->erase(it);
+		}
+		else {
+			it++;
+		}
+	}
+}
+
+void SdlRenderBackend::runOnRenderThread(std::function<void()> job) {
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	// Resources may still be referenced by the frame in flight, let it finish first
+	this->signal.wait(lock, [this] { return !this->framePending && !this->jobPending; });
+
+	this->job = job;
+	this->jobPending = true;
+	this->signal.notify_all();
+
+	this->signal.wait(lock, [this] { return !this->jobPending; });
+}
+
+SdlRenderBackend::~SdlRenderBackend() {
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		this->signal.wait(lock, [this] { return !this->framePending; });
+		this->quit = true;
+		this->signal.notify_all();
+	}
+
+	this->renderThread->join();
+
+	delete this->renderThread;
+	delete this->building;
+	delete this->submitting;
+	delete this->textCache;
+	delete this->textKey;
+
+	SDL_DestroyWindow(this->window);
+}
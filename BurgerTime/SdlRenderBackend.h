@@ -0,0 +1,64 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include "RenderBackend.h"
+#include "DrawList.h"
+
+const int TEXT_CACHE_LIFETIME_FRAMES = 120;
+
+struct CachedText {
+	TTF_Font* font;
+	SDL_Texture* texture;
+	int width;
+	int height;
+	long lastUsedFrame;
+};
+
+class SdlRenderBackend : public RenderBackend {
+	SDL_Window* window;
+	SDL_Renderer* renderer;
+
+	DrawList* building;
+	DrawList* submitting;
+
+	std::thread* renderThread;
+	std::mutex mutex;
+	std::condition_variable signal;
+	std::function<void()> job;
+	bool jobPending;
+	bool framePending;
+	bool quit;
+
+	std::unordered_map<std::string, CachedText>* textCache;
+	std::string* textKey;
+	long submittedFrames;
+
+public:
+	SdlRenderBackend(const char* title, int width, int height);
+
+	virtual SDL_Texture* loadTexture(const char* bmpPath);
+	virtual void getTextureSize(SDL_Texture* texture, int* width, int* height);
+	virtual void destroyTexture(SDL_Texture* texture);
+
+	virtual TTF_Font* openFont(const char* fontPath, int fontSize);
+	virtual void closeFont(TTF_Font* font);
+
+	virtual void clear();
+	virtual void drawTexture(SDL_Texture* texture, SDL_Rect* destination);
+	virtual void drawText(TTF_Font* font, const char* message, SDL_Color color, int x, int y, int scale);
+	virtual void fillRect(SDL_Rect* destination, SDL_Color color);
+	virtual void present();
+
+	virtual ~SdlRenderBackend();
+
+private:
+	void renderLoop();
+	void submit(DrawList* drawList);
+	CachedText* getCachedText(DrawCommand& command);
+	void evictText(TTF_Font* font, long unusedSince);
+	void runOnRenderThread(std::function<void()> job);
+};
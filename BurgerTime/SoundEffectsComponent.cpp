@@ -2,84 +2,98 @@
 #include "Engine.h"
 
 SoundEffectsComponent::SoundEffectsComponent(Engine* engine, Entity* entity) : Component(engine, entity) {
-	this->backgroundMusic = Mix_LoadMUS("resources/sounds/music.mp3");
+	this->audio = engine->getAudio();
 
-	this->intro = Mix_LoadWAV("resources/sounds/intro.mp3");
-	this->loose = Mix_LoadWAV("resources/sounds/loose.mp3");
-	this->win = Mix_LoadWAV("resources/sounds/win.mp3");
+	this->backgroundMusic = this->audio->loadMusic("resources/sounds/music.mp3");
 
-	this->pepper = Mix_LoadWAV("resources/sounds/pepper.mp3");
-	this->ingredientStep = Mix_LoadWAV("resources/sounds/ingredient_step.mp3");
-	this->ingredientHit = Mix_LoadWAV("resources/sounds/ingredient_hit.mp3");
-	this->squashed = Mix_LoadWAV("resources/sounds/squashed.mp3");
+	this->intro = this->audio->loadEffect("resources/sounds/intro.mp3");
+	this->loose = this->audio->loadEffect("resources/sounds/loose.mp3");
+	this->win = this->audio->loadEffect("resources/sounds/win.mp3");
+
+	this->pepper = this->audio->loadEffect("resources/sounds/pepper.mp3");
+	this->ingredientStep = this->audio->loadEffect("resources/sounds/ingredient_step.mp3");
+	this->ingredientHit = this->audio->loadEffect("resources/sounds/ingredient_hit.mp3");
+	this->squashed = this->audio->loadEffect("resources/sounds/squashed.mp3");
 
 	this->dying = false;
 
 	this->performSubscriptions();
 
-	Mix_PlayChannel(-1, this->intro, 0);
+	this->audio->playEffect(this->intro);
 }
 
 void SoundEffectsComponent::update(double dt) {
 	if (this->hasReceived(GAME_STARTED)) {
-		Mix_PlayMusic(this->backgroundMusic, -1);
+		this->audio->playMusic(this->backgroundMusic);
 	}
 
 	if (this->hasReceived(ENEMY_ATTACK) && !this->dying) {
-		Mix_RewindMusic();
-		Mix_PauseMusic();
+		this->audio->rewindMusic();
+		this->audio->pauseMusic();
 
-		Mix_PlayChannel(-1, this->loose, 0);
+		this->audio->playEffect(this->loose);
 		this->dying = true;
 	}
 	if (this->hasReceived(PLAYER_DIED) && !this->hasReceived(GAME_OVER)) {
-		Mix_ResumeMusic();
+		this->audio->resumeMusic();
 		this->dying = false;
 	}
 	if (this->hasReceived(GAME_VICTORY)) {
-		Mix_PauseMusic();
-		Mix_PlayChannel(-1, this->win, 0);
+		this->audio->pauseMusic();
+		this->audio->playEffect(this->win);
 	}
 
 	if (this->hasReceived(PEPPER_THROWN)) {
-		Mix_PlayChannel(-1, this->pepper, 0);
+		this->audio->playEffect(this->pepper);
 	}
 	if (this->hasReceived(ON_INGREDIENT_1)) {
-		Mix_PlayChannel(-1, this->ingredientStep, 0);
+		this->audio->playEffect(this->ingredientStep);
 	}
 	if (this->hasReceived(INGREDIENT_INGREDIENT_HIT)) {
-		Mix_PlayChannel(-1, this->ingredientHit, 0);
+		this->audio->playEffect(this->ingredientHit);
 	}
 	if (this->hasReceived(ENEMY_SQUASHED)) {
-		Mix_PlayChannel(-1, this->squashed, 0);
+		this->audio->playEffect(this->squashed);
 	}
 
 	this->clearMessages();
 }
 
 void SoundEffectsComponent::performSubscriptions() {
-	this->engine->getMessageDispatcher()->subscribe(GAME_STARTED, this);
+	this->subscriptions = new std::vector<Subscription>();
+
+	this->subscribe(GAME_STARTED);
 
-	this->engine->getMessageDispatcher()->subscribe(ENEMY_ATTACK, this);
-	this->engine->getMessageDispatcher()->subscribe(PLAYER_DIED, this);
-	this->engine->getMessageDispatcher()->subscribe(GAME_OVER, this);
-	this->engine->getMessageDispatcher()->subscribe(GAME_VICTORY, this);
+	this->subscribe(ENEMY_ATTACK);
+	this->subscribe(PLAYER_DIED);
+	this->subscribe(GAME_OVER);
+	this->subscribe(GAME_VICTORY);
+
+	this->subscribe(PEPPER_THROWN);
+	this->subscribe(ON_INGREDIENT_1);
+	this->subscribe(INGREDIENT_INGREDIENT_HIT);
+	this->subscribe(ENEMY_SQUASHED);
+}
 
-	this->engine->getMessageDispatcher()->subscribe(PEPPER_THROWN, this);
-	this->engine->getMessageDispatcher()->subscribe(ON_INGREDIENT_1, this);
-	this->engine->getMessageDispatcher()->subscribe(INGREDIENT_INGREDIENT_HIT, this);
-	this->engine->getMessageDispatcher()->subscribe(ENEMY_SQUASHED, this);
+void SoundEffectsComponent::subscribe(Message message) {
+	this->subscriptions->push_back(this->engine->getMessageDispatcher()->subscribe(message, this));
 }
 
 SoundEffectsComponent::~SoundEffectsComponent() {
-	Mix_FreeChunk(this->intro);
-	Mix_FreeChunk(this->loose);
-	Mix_FreeChunk(this->win);
+	for (Subscription subscription : *this->subscriptions) {
+		this->engine->getMessageDispatcher()->unsubscribe(subscription);
+	}
+
+	delete this->subscriptions;
+
+	this->audio->freeEffect(this->intro);
+	this->audio->freeEffect(this->loose);
+	this->audio->freeEffect(this->win);
 
-	Mix_FreeChunk(this->pepper);
-	Mix_FreeChunk(this->ingredientStep);
-	Mix_FreeChunk(this->ingredientHit);
-	Mix_FreeChunk(this->squashed);
+	this->audio->freeEffect(this->pepper);
+	this->audio->freeEffect(this->ingredientStep);
+	this->audio->freeEffect(this->ingredientHit);
+	this->audio->freeEffect(this->squashed);
 
-	Mix_FreeMusic(this->backgroundMusic);
+	this->audio->freeMusic(this->backgroundMusic);
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 #include "Component.h"
-#include <SDL_mixer.h>
+#include "AudioBackend.h"
+#include "MessageDispatcher.h"
 
 class SoundEffectsComponent : public Component {
+	AudioBackend* audio;
 	Mix_Music* backgroundMusic;
 
 	Mix_Chunk* intro;
@@ -15,6 +17,7 @@ class SoundEffectsComponent : public Component {
 	Mix_Chunk *squashed;
 
 	bool dying;
+	std::vector<Subscription>* subscriptions;
 
 public:
 	SoundEffectsComponent(Engine* engine, Entity* entity);
@@ -25,5 +28,6 @@ public:
 
 private:
 	void performSubscriptions();
+	void subscribe(Message message);
 };
 
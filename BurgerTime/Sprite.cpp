@@ -1,9 +1,9 @@
 #include "Sprite.h"
 #include "Constants.h"
 
-Sprite::Sprite(SDL_Renderer* renderer, const char* spritePath) : Sprite(renderer, spritePath, 0, 0, 0) {}
+Sprite::Sprite(RenderBackend* renderer, const char* spritePath) : Sprite(renderer, spritePath, 0, 0, 0) {}
 
-Sprite::Sprite(SDL_Renderer * renderer, const char* spritePattern, int indexStart, int indexEnd, int millisecsPerFrame) {
+Sprite::Sprite(RenderBackend* renderer, const char* spritePattern, int indexStart, int indexEnd, int millisecsPerFrame) {
 	this->renderer = renderer;
 	this->textures = new std::vector<SDL_Texture*>();
 	this->millisecsPerFrame = millisecsPerFrame;
@@ -13,29 +13,28 @@ Sprite::Sprite(SDL_Renderer * renderer, const char* spritePattern, int indexStar
 		char spritePath[1000];
 		snprintf(spritePath, 1000, spritePattern, i);
 
-		SDL_Surface* spriteSurface = SDL_LoadBMP(spritePath);
-		this->textures->push_back(SDL_CreateTextureFromSurface(this->renderer, spriteSurface));
-
-		SDL_FreeSurface(spriteSurface);
+		this->textures->push_back(this->renderer->loadTexture(spritePath));
 	}
 }
 
-void Sprite::draw(int x, int y, double dt) {
+void Sprite::update(double dt) {
+	this->timeElapsed += dt;
+}
+
+void Sprite::draw(int x, int y) {
 	SDL_Rect spritePosition;
 
 	int frameIndex = this->millisecsPerFrame > 0 ? ((int)(this->timeElapsed * 1000) / this->millisecsPerFrame) % this->textures->size() : 0;
 	SDL_Texture* texture = this->textures->at(frameIndex);
 
-	SDL_QueryTexture(texture, nullptr, nullptr, &spritePosition.w, &spritePosition.h);
+	this->renderer->getTextureSize(texture, &spritePosition.w, &spritePosition.h);
 
 	spritePosition.w *= RESOLUTION_MULTIPLIER;
 	spritePosition.h *= RESOLUTION_MULTIPLIER;
 	spritePosition.x = x * RESOLUTION_MULTIPLIER - spritePosition.w / 2;
 	spritePosition.y = y * RESOLUTION_MULTIPLIER - spritePosition.h / 2;
 
-	SDL_RenderCopy(this->renderer, texture, nullptr, &spritePosition);
-
-	this->timeElapsed += dt;
+	this->renderer->drawTexture(texture, &spritePosition);
 }
 
 void Sprite::resetAnimation() {
@@ -44,7 +43,7 @@ void Sprite::resetAnimation() {
 
 Sprite::~Sprite() {
 	for (auto i = this->textures->begin(); i != this->textures->end(); i++) {
-		SDL_DestroyTexture(*i);
+		this->renderer->destroyTexture(*i);
 	}
 
 	delete this->textures;
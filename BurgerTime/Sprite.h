@@ -2,19 +2,22 @@
 #include <vector>
 #include "SDL.h"
 #include "Constants.h"
+#include "RenderBackend.h"
+#include "ArenaObject.h"
 
-class Sprite {
-	SDL_Renderer * renderer;
+class Sprite : public ArenaObject {
+	RenderBackend* renderer;
 	std::vector<SDL_Texture*>* textures;
 	int millisecsPerFrame;
 	double timeElapsed;
 
 public:
-	Sprite(SDL_Renderer* renderer, const char* spritePath);
-	Sprite(SDL_Renderer* renderer, const char* spritePattern, int indexStart, int indexEnd, int millisecsPerFrame);
+	Sprite(RenderBackend* renderer, const char* spritePath);
+	Sprite(RenderBackend* renderer, const char* spritePattern, int indexStart, int indexEnd, int millisecsPerFrame);
 
-	void draw(int x, int y, double dt);
+	void update(double dt);
+	void draw(int x, int y);
 	void resetAnimation();
 
 	~Sprite();
-};
\ No newline at end of file
+};
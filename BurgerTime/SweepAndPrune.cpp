@@ -0,0 +1,203 @@
+#include "SweepAndPrune.h"
+#include "Engine.h"
+#include "EntityRegistry.h"
+#include <algorithm>
+
+// Boxes are widened a little so that rounding in the edges never drops a pair the exact test would accept
+const double SWEEP_MARGIN = 0.5;
+
+// A start sorts before an end at the same value, so boxes that only touch still count as a pair
+static bool precedes(const SweepEndpoint& first, const SweepEndpoint& second) {
+	return first.value < second.value || (first.value == second.value && !first.isMax && second.isMax);
+}
+
+SweepAndPrune::SweepAndPrune(Engine* engine) {
+	this->engine = engine;
+	this->registry = engine->getEntityRegistry();
+	this->words = 0;
+
+	for (int group = 0; group < BODY_GROUPS; group++) {
+		this->groups[group] = nullptr;
+		this->groupSpeeds[group] = 0;
+		this->groupStarts[group] = 0;
+	}
+
+	this->groupStarts[BODY_GROUPS] = 0;
+}
+
+// Bodies that can move further than their own size in one tick are stretched up and down by as far as
+// speedY takes them in a tick, so pairs that only meet part way through the tick are still found
+void SweepAndPrune::setGroup(BodyGroup group, std::vector<Entity*>* bodies, double speedY) {
+	this->groups[group] = bodies;
+	this->groupSpeeds[group] = speedY;
+}
+
+// Bodies are numbered group by group in list order, so the pairs of one group come out in list order.
+// The lists must be complete by now; an entity belongs to at most one sweep
+void SweepAndPrune::build() {
+	this->bodies.clear();
+	this->speeds.clear();
+
+	for (int group = 0; group < BODY_GROUPS; group++) {
+		this->groupStarts[group] = (int)this->bodies.size();
+
+		if (this->groups[group] != nullptr) {
+			this->bodies.insert(this->bodies.end(), this->groups[group]->begin(), this->groups[group]->end());
+			this->speeds.resize(this->bodies.size(), this->groupSpeeds[group]);
+		}
+	}
+
+	int count = (int)this->bodies.size();
+
+	this->groupStarts[BODY_GROUPS] = count;
+	this->words = (count + 63) / 64;
+	this->endpointsX.clear();
+	this->endpointsY.clear();
+	this->slotsX.assign(count * 2, -1);
+	this->slotsY.assign(count * 2, -1);
+	this->overlapsX.assign(count * this->words, 0);
+	this->overlapsY.assign(count * this->words, 0);
+	this->found.reserve(count);
+
+	for (int body = 0; body < count; body++) {
+		double minX, maxX, minY, maxY;
+
+		this->bounds(body, &minX, &maxX, &minY, &maxY);
+		this->endpointsX.push_back({ minX, body, false });
+		this->endpointsX.push_back({ maxX, body, true });
+		this->endpointsY.push_back({ minY, body, false });
+		this->endpointsY.push_back({ maxY, body, true });
+
+		this->registry->setSweep(this->bodies[body]->getRegistryIndex(), this, body);
+	}
+
+	std::sort(this->endpointsX.begin(), this->endpointsX.end(), precedes);
+	std::sort(this->endpointsY.begin(), this->endpointsY.end(), precedes);
+
+	for (int slot = 0; slot < count * 2; slot++) {
+		this->slotsX[this->endpointsX[slot].body * 2 + this->endpointsX[slot].isMax] = slot;
+		this->slotsY[this->endpointsY[slot].body * 2 + this->endpointsY[slot].isMax] = slot;
+	}
+
+	for (int first = 0; first < count; first++) {
+		for (int second = first + 1; second < count; second++) {
+			this->setOverlap(this->overlapsX, first, second, this->slotsX[first * 2] < this->slotsX[second * 2 + 1]
+				&& this->slotsX[second * 2] < this->slotsX[first * 2 + 1]);
+			this->setOverlap(this->overlapsY, first, second, this->slotsY[first * 2] < this->slotsY[second * 2 + 1]
+				&& this->slotsY[second * 2] < this->slotsY[first * 2 + 1]);
+		}
+	}
+}
+
+void SweepAndPrune::refresh(int body) {
+	double minX, maxX, minY, maxY;
+
+	this->bounds(body, &minX, &maxX, &minY, &maxY);
+	this->move(this->endpointsX, this->slotsX, this->overlapsX, body, minX, maxX);
+	this->move(this->endpointsY, this->slotsY, this->overlapsY, body, minY, maxY);
+}
+
+// The bodies of a group whose boxes overlap the entity's, in list order so that callers react to hits
+// in the same order a full scan would. The entity must be one of the bodies
+const std::vector<Entity*>& SweepAndPrune::query(Entity* entity, BodyGroup group) {
+	int body = this->registry->getSweepSlot(entity->getRegistryIndex());
+	Uint64* overlapsX = this->overlapsX.data() + body * this->words;
+	Uint64* overlapsY = this->overlapsY.data() + body * this->words;
+	int last = this->groupStarts[group + 1];
+
+	this->found.clear();
+
+	for (int other = this->groupStarts[group]; other < last;) {
+		Uint64 pairs = (overlapsX[other / 64] & overlapsY[other / 64]) >> (other % 64);
+
+		if (pairs == 0) {
+			other = (other / 64 + 1) * 64;
+			continue;
+		}
+
+		if (pairs & 1) {
+			this->found.push_back(this->bodies[other]);
+		}
+
+		other++;
+	}
+
+	return this->found;
+}
+
+// The reach follows the current tick length, so a tick rate changed mid-game applies from each body's
+// next move. The body that falls is the one that moves, so its own reach always covers the fall
+void SweepAndPrune::bounds(int body, double* minX, double* maxX, double* minY, double* maxY) {
+	int index = this->bodies[body]->getRegistryIndex();
+	double x = this->registry->getX(index);
+	double y = this->registry->getY(index);
+	double halfWidth = this->registry->getExtentX(index) / 2 + SWEEP_MARGIN;
+	double reachY = this->speeds[body] * this->engine->getSecondsPerTick();
+	double halfHeight = this->registry->getExtentY(index) / 2 + reachY + SWEEP_MARGIN;
+
+	*minX = x - halfWidth;
+	*maxX = x + halfWidth;
+	*minY = y - halfHeight;
+	*maxY = y + halfHeight;
+}
+
+// The edge leading the move is sorted first, so the two edges of the body never have to pass each other
+void SweepAndPrune::move(std::vector<SweepEndpoint>& endpoints, std::vector<int>& slots, std::vector<Uint64>& overlaps, int body, double min, double max) {
+	int minSlot = slots[body * 2];
+	int maxSlot = slots[body * 2 + 1];
+	bool minLeads = min < endpoints[minSlot].value;
+
+	endpoints[minSlot].value = min;
+	endpoints[maxSlot].value = max;
+
+	if (minLeads) {
+		this->sift(endpoints, slots, overlaps, minSlot);
+		this->sift(endpoints, slots, overlaps, slots[body * 2 + 1]);
+	}
+	else {
+		this->sift(endpoints, slots, overlaps, maxSlot);
+		this->sift(endpoints, slots, overlaps, slots[body * 2]);
+	}
+}
+
+// Insertion sorts one edge back into place. Passing a start or an end of another body is where that
+// pair starts or stops overlapping on this axis
+void SweepAndPrune::sift(std::vector<SweepEndpoint>& endpoints, std::vector<int>& slots, std::vector<Uint64>& overlaps, int slot) {
+	SweepEndpoint moving = endpoints[slot];
+	int last = (int)endpoints.size() - 1;
+
+	for (; slot > 0 && precedes(moving, endpoints[slot - 1]); slot--) {
+		SweepEndpoint& other = endpoints[slot - 1];
+
+		if (moving.isMax != other.isMax) {
+			this->setOverlap(overlaps, moving.body, other.body, !moving.isMax);
+		}
+
+		endpoints[slot] = other;
+		slots[other.body * 2 + other.isMax] = slot;
+	}
+
+	for (; slot < last && precedes(endpoints[slot + 1], moving); slot++) {
+		SweepEndpoint& other = endpoints[slot + 1];
+
+		if (moving.isMax != other.isMax) {
+			this->setOverlap(overlaps, moving.body, other.body, moving.isMax);
+		}
+
+		endpoints[slot] = other;
+		slots[other.body * 2 + other.isMax] = slot;
+	}
+
+	endpoints[slot] = moving;
+	slots[moving.body * 2 + moving.isMax] = slot;
+}
+
+void SweepAndPrune::setOverlap(std::vector<Uint64>& overlaps, int first, int second, bool overlap) {
+	Uint64 firstBit = (Uint64)1 << (first % 64);
+	Uint64 secondBit = (Uint64)1 << (second % 64);
+	Uint64& firstWord = overlaps[second * this->words + first / 64];
+	Uint64& secondWord = overlaps[first * this->words + second / 64];
+
+	firstWord = overlap ? firstWord | firstBit : firstWord & ~firstBit;
+	secondWord = overlap ? secondWord | secondBit : secondWord & ~secondBit;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include "SDL.h"
+#include "ArenaObject.h"
+
+class Engine;
+class Entity;
+class EntityRegistry;
+
+enum BodyGroup { BODY_PLAYER, BODY_PEPPER, BODY_ENEMIES, BODY_INGREDIENTS, BODY_GROUPS };
+
+struct SweepEndpoint {
+	double value;
+	int body;
+	bool isMax;
+};
+
+// Sweep and prune over everything that moves. The box edges are kept sorted along each axis and a
+// body that moves is insertion sorted back into place, which is only a swap or two since bodies move
+// a little each tick. Every swap of one body's start with another's end turns that pair's overlap on
+// that axis on or off, so the overlapping pairs are always current and a query only reads them
+class SweepAndPrune : public ArenaObject {
+	Engine* engine;
+	EntityRegistry* registry;
+	std::vector<Entity*>* groups[BODY_GROUPS];
+	double groupSpeeds[BODY_GROUPS];
+	int groupStarts[BODY_GROUPS + 1];
+
+	std::vector<Entity*> bodies;
+	std::vector<double> speeds;
+	std::vector<SweepEndpoint> endpointsX;
+	std::vector<SweepEndpoint> endpointsY;
+	std::vector<int> slotsX;
+	std::vector<int> slotsY;
+	std::vector<Uint64> overlapsX;
+	std::vector<Uint64> overlapsY;
+	int words;
+
+	std::vector<Entity*> found;
+
+public:
+	SweepAndPrune(Engine* engine);
+
+	void setGroup(BodyGroup group, std::vector<Entity*>* bodies, double speedY = 0);
+	void build();
+	void refresh(int body);
+
+	const std::vector<Entity*>& query(Entity* entity, BodyGroup group);
+
+private:
+	void bounds(int body, double* minX, double* maxX, double* minY, double* maxY);
+	void move(std::vector<SweepEndpoint>& endpoints, std::vector<int>& slots, std::vector<Uint64>& overlaps, int body, double min, double max);
+	void sift(std::vector<SweepEndpoint>& endpoints, std::vector<int>& slots, std::vector<Uint64>& overlaps, int slot);
+	void setOverlap(std::vector<Uint64>& overlaps, int first, int second, bool overlap);
+};
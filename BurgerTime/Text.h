@@ -2,13 +2,14 @@
 #include <string>
 #include "SDL_ttf.h"
 #include "Coordinate.h"
+#include "RenderBackend.h"
 
 class Text {
-	SDL_Renderer* renderer;
+	RenderBackend* renderer;
 	TTF_Font* font;
 
 public:
-	Text(SDL_Renderer* renderer, const char* fontPath, int fontSize);
+	Text(RenderBackend* renderer, const char* fontPath, int fontSize);
 	void draw(Coordinate* coordinate, const char *message, Uint8 red = 255, Uint8 green = 255, Uint8 blue = 255);
 	~Text();
 };
\ No newline at end of file
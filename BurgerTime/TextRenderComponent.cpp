@@ -5,11 +5,12 @@ TextRenderComponent::TextRenderComponent(Engine* engine, Entity* entity, std::st
 	this->message = message;
 }
 
-void TextRenderComponent::update(double dt) {
-	Coordinate* backgroundPosition = new Coordinate(entity->getPosition()->getX() + 1, entity->getPosition()->getY() + 1);
+void TextRenderComponent::render(double alpha) {
+	Coordinate position = entity->getPosition();
+	Coordinate backgroundPosition(position.getX() + 1, position.getY() + 1);
 
-	this->text->draw(backgroundPosition, this->message->c_str(), 0, 0, 0);
-	this->text->draw(entity->getPosition(), this->message->c_str());
+	this->text->draw(&backgroundPosition, this->message->c_str(), 0, 0, 0);
+	this->text->draw(&position, this->message->c_str());
 }
 
 TextRenderComponent::~TextRenderComponent() {
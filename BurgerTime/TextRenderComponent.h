@@ -9,7 +9,7 @@ class TextRenderComponent : public Component {
 public:
 	TextRenderComponent(Engine* engine, Entity* entity, std::string* message, Text* text);
 
-	virtual void update(double dt);
+	virtual void render(double alpha);
 
 	~TextRenderComponent();
 };
@@ -0,0 +1,26 @@
+#include "TileEntity.h"
+#include "RenderComponent.h"
+
+TileEntity::TileEntity(Engine* engine, Coordinate* position, Sprite* sprite) : TileEntity(engine, position, sprite, new Coordinate(0, 0)) { }
+
+TileEntity::TileEntity(Engine* engine, Coordinate* position, Sprite* sprite, Coordinate* offset) : Entity(engine, position) {
+	this->fixedComponents.set(new RenderComponent(engine, this, sprite, offset));
+}
+
+void TileEntity::initFixedComponents() {
+	this->fixedComponents.init();
+}
+
+void TileEntity::updateFixedComponents(double dt, Profiler* profiler) {
+	this->fixedComponents.update(dt, profiler);
+}
+
+void TileEntity::animateFixedComponents(double dt) {
+	this->fixedComponents.animate(dt);
+}
+
+void TileEntity::renderFixedComponents(double alpha) {
+	this->fixedComponents.render(alpha);
+}
+
+TileEntity::~TileEntity() { }
\ No newline at end of file
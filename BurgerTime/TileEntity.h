@@ -0,0 +1,25 @@
+#pragma once
+#include "Entity.h"
+#include "ComponentSet.h"
+
+class RenderComponent;
+class Sprite;
+
+typedef ComponentSet<RenderComponent> TileComponents;
+
+// A static sprite: floors, stairs, dishes and the slices of an ingredient
+class TileEntity : public Entity {
+	TileComponents fixedComponents;
+
+public:
+	TileEntity(Engine* engine, Coordinate* position, Sprite* sprite);
+	TileEntity(Engine* engine, Coordinate* position, Sprite* sprite, Coordinate* offset);
+
+	~TileEntity();
+
+protected:
+	virtual void initFixedComponents();
+	virtual void updateFixedComponents(double dt, Profiler* profiler);
+	virtual void animateFixedComponents(double dt);
+	virtual void renderFixedComponents(double alpha);
+};
@@ -0,0 +1,45 @@
+#include "WalkCollideComponent.h"
+#include "PlayerEntity.h"
+#include "Engine.h"
+
+WalkCollideComponent::WalkCollideComponent(Engine* engine, Entity* entity, LevelGeometry* geometry, PlayerEntity* nearFloorPlayer) : Component(engine, entity) {
+	this->geometry = geometry;
+	this->nearFloorPlayer = nearFloorPlayer;
+}
+
+void WalkCollideComponent::update(double dt) {
+	this->collideFloors();
+	this->collide(GEOMETRY_LEFT_LIMIT, INTERSECT_LIMIT_LEFT);
+	this->collide(GEOMETRY_RIGHT_LIMIT, INTERSECT_LIMIT_RIGHT);
+	this->collide(GEOMETRY_STAIR, INTERSECT_STAIRS);
+	this->collide(GEOMETRY_UP_STAIR_LIMIT, INTERSECT_UP_STAIRS);
+	this->collide(GEOMETRY_DOWN_STAIR_LIMIT, INTERSECT_DOWN_STAIRS);
+}
+
+void WalkCollideComponent::collideFloors() {
+	int order = -1;
+	Entity* floor;
+
+	while ((floor = this->geometry->nextFloor(this->entity, &order)) != nullptr) {
+		double heightDiff = floor->getPosition().getY() - this->entity->getPosition().getY();
+
+		bool nearFloor = floor->isIntersecting(this->entity, 16, 8)
+			&& heightDiff > 3 && heightDiff < 13;
+		bool onFloor = this->entity->isIntersecting(floor)
+			&& heightDiff > 6.5 && heightDiff < 9.5;
+
+		if (this->nearFloorPlayer != nullptr && nearFloor && !onFloor) {
+			this->nearFloorPlayer->notifyNearFloor(floor);
+		}
+
+		if (onFloor) {
+			this->entity->receive(ON_FLOOR);
+		}
+	}
+}
+
+void WalkCollideComponent::collide(GeometryKind kind, Message message) {
+	if (this->geometry->isTouching(this->entity, kind)) {
+		this->entity->receive(message);
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "Component.h"
+#include "LevelGeometry.h"
+
+class PlayerEntity;
+
+// Everything a walking entity learns from the level: whether it stands on a floor, sits on a stair and
+// has reached the end of either. The player is also pulled onto floors it walks close to
+class WalkCollideComponent : public Component {
+	LevelGeometry* geometry;
+	PlayerEntity* nearFloorPlayer;
+
+public:
+	WalkCollideComponent(Engine* engine, Entity* entity, LevelGeometry* geometry, PlayerEntity* nearFloorPlayer);
+
+	virtual void update(double dt);
+
+private:
+	void collideFloors();
+	void collide(GeometryKind kind, Message message);
+};
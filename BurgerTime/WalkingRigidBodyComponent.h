@@ -1,12 +1,34 @@
 #pragma once
 #include "RigidBodyComponent.h"
+#include "Constants.h"
 
+// Owner is the walking entity type and provides WALKING_SPEED_PROPORTION, so player and enemy
+// speeds are known at compile time
+template <typename Owner>
 class WalkingRigidBodyComponent : public RigidBodyComponent {
-	bool isPlayer;
-
 public:
-	WalkingRigidBodyComponent(Engine* engine, Entity* entity, bool isPlayer);
+	WalkingRigidBodyComponent(Engine* engine, Owner* owner) : RigidBodyComponent(engine, owner) { }
 
-	virtual void update(double dt);
-};
+	virtual void update(double dt) {
+		double speedCoeficient = Owner::WALKING_SPEED_PROPORTION;
+
+		this->entity->setVelocity(0, 0);
 
+		switch (this->entity->getAction()) {
+			case WALK_LEFT:
+				this->entity->setVelocity(-PLAYER_HORIZONTAL_VELOCITY * speedCoeficient, 0);
+				break;
+			case WALK_RIGHT:
+				this->entity->setVelocity(PLAYER_HORIZONTAL_VELOCITY * speedCoeficient, 0);
+				break;
+			case GO_UPSTAIRS:
+				this->entity->setVelocity(0, -PLAYER_VERTICAL_VELOCITY * speedCoeficient);
+				break;
+			case GO_DOWNSTAIRS:
+				this->entity->setVelocity(0, PLAYER_VERTICAL_VELOCITY * speedCoeficient);
+				break;
+		}
+
+		RigidBodyComponent::update(dt);
+	}
+};
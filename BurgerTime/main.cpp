@@ -1,14 +1,51 @@
 #include <string>
 #include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include "Engine.h"
 #include "Game.h"
 #include "Constants.h"
 
+void runHeadless(Engine* engine, long ticks) {
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (long tick = 0; tick < ticks && engine->update(); tick++);
+
+	long tick = (long)engine->getCurrentTick();
+	double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+	printf("%ld ticks in %.3f s (%.0f ticks/s)\n", tick, seconds, seconds > 0 ? tick / seconds : 0);
+}
+
 int main(int argc, char* argv[]) {
 	Engine engine;
 	Game* game = new Game(&engine);
+	long headlessTicks = 0;
 
-	if (engine.init(game, ORIGINAL_WIDTH * RESOLUTION_MULTIPLIER, ORIGINAL_HEIGHT * RESOLUTION_MULTIPLIER)) {
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			headlessTicks = atol(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "--profile") == 0) {
+			engine.getProfiler()->setOutputPath(argv[i + 1]);
+			engine.getProfiler()->setEnabled(true);
+		}
+		else if (strcmp(argv[i], "--record") == 0) {
+			engine.startRecording(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "--replay") == 0 && !engine.startReplay(argv[i + 1])) {
+			printf("Could not read replay %s\n", argv[i + 1]);
+			delete game;
+			return 1;
+		}
+	}
+
+	if (headlessTicks > 0) {
+		if (engine.initHeadless(game)) {
+			runHeadless(&engine, headlessTicks);
+		}
+	}
+	else if (engine.init(game, ORIGINAL_WIDTH * RESOLUTION_MULTIPLIER, ORIGINAL_HEIGHT * RESOLUTION_MULTIPLIER)) {
 		engine.setFpsLimit(60);
 		while (engine.update());
 	}
@@ -16,4 +53,4 @@ int main(int argc, char* argv[]) {
 	delete game;
 	
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "BatchRunner.h"
+
+int main(int argc, char* argv[]) {
+	const char* levelPath = "resources/levels/default.bgtm";
+	long sessions = 1000;
+	long ticks = 3600;
+	int maxWorkers = (int)std::thread::hardware_concurrency();
+	Uint64 seed = 1;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--level") == 0) levelPath = argv[i + 1];
+		else if (strcmp(argv[i], "--sessions") == 0) sessions = atol(argv[i + 1]);
+		else if (strcmp(argv[i], "--ticks") == 0) ticks = atol(argv[i + 1]);
+		else if (strcmp(argv[i], "--workers") == 0) maxWorkers = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], nullptr, 10);
+	}
+
+	if (maxWorkers < 1) {
+		maxWorkers = 1;
+	}
+
+	BatchRunner runner(levelPath, ticks, seed);
+	double singleWorkerRate = 0;
+
+	printf("%s: %ld sessions x %ld ticks\n", levelPath, sessions, ticks);
+	printf("%8s %14s %10s %9s %11s\n", "workers", "ticks/s", "seconds", "speedup", "efficiency");
+
+	for (int workers = 1; workers <= maxWorkers; workers = workers < maxWorkers && workers * 2 > maxWorkers ? maxWorkers : workers * 2) {
+		BatchResult result = runner.run(workers, sessions);
+		double rate = result.seconds > 0 ? result.ticks / result.seconds : 0;
+
+		if (workers == 1) {
+			singleWorkerRate = rate;
+		}
+
+		double speedup = singleWorkerRate > 0 ? rate / singleWorkerRate : 0;
+		printf("%8d %14.0f %10.3f %8.2fx %10.0f%%\n", workers, rate, result.seconds, speedup, speedup / workers * 100);
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include "BenchScenes.h"
+#include "Constants.h"
+#include <cstring>
+
+const int BENCH_LEFT = 24;
+const int BENCH_RIGHT = 216;
+const int BENCH_TILE = 16;
+const int BENCH_ROW_GAP = 32;
+const int BENCH_INTRO_TICKS = 300;
+const int BENCH_INPUT_PERIOD = 120;
+
+static void addEntry(LevelData* level, const char* type, int x, int y, int extra) {
+	LevelEntry entry;
+
+	strncpy(entry.type, type, sizeof(entry.type) - 1);
+	entry.type[sizeof(entry.type) - 1] = '\0';
+	entry.position[0] = x;
+	entry.position[1] = y;
+	entry.extra = extra;
+
+	level->push_back(entry);
+}
+
+// Rows of floors joined by stairs, laid out the same way as the shipped levels
+static void addGrid(LevelData* level, int top, int rows, int stairSpacing) {
+	for (int row = 0; row < rows; row++) {
+		int y = top + row * BENCH_ROW_GAP;
+
+		for (int x = BENCH_LEFT; x <= BENCH_RIGHT; x += BENCH_TILE) {
+			addEntry(level, "FLOOR", x, y, (x - BENCH_LEFT) % 48 == 0 ? 1 : 0);
+		}
+	}
+
+	for (int x = BENCH_LEFT; x <= BENCH_RIGHT; x += stairSpacing) {
+		for (int row = 0; row + 1 < rows; row++) {
+			int y = top + row * BENCH_ROW_GAP;
+
+			addEntry(level, "STAIR", x, y + 7, 0);
+			addEntry(level, "STAIR", x, y + 23, 0);
+		}
+	}
+}
+
+static void addIngredientColumns(LevelData* level, int top, int rows) {
+	const char* ingredients[] = { "BREAD_TOP", "LETTUCE", "CHEESE", "MEAT", "TOMATO", "BREAD_BOTTOM" };
+
+	for (int x = 48; x <= 192; x += 48) {
+		addEntry(level, "DISH", x, top + rows * BENCH_ROW_GAP, 0);
+
+		for (int row = 0; row < rows; row++) {
+			addEntry(level, ingredients[row % 6], x, top + row * BENCH_ROW_GAP, 0);
+		}
+	}
+}
+
+static void addEnemies(LevelData* level, int top, int rows, int perRow) {
+	const char* enemies[] = { "SAUSAGE", "EGG", "CUCUMBER" };
+	int count = 0;
+
+	for (int row = 0; row < rows; row++) {
+		for (int i = 0; i < perRow; i++) {
+			int x = BENCH_LEFT + i * (BENCH_RIGHT - BENCH_LEFT) / (perRow > 1 ? perRow - 1 : 1);
+
+			addEntry(level, enemies[count % 3], x, top + row * BENCH_ROW_GAP - 8, (count % 6) * 500);
+			count++;
+		}
+	}
+}
+
+std::vector<BenchScene> createBenchScenes() {
+	std::vector<BenchScene> scenes;
+
+	// Hundreds of static tiles, stairs on every column
+	LevelData* tiles = new LevelData();
+	addGrid(tiles, 32, 7, BENCH_TILE);
+	addEntry(tiles, "PLAYER", 120, 32 + 6 * BENCH_ROW_GAP - 8, 0);
+	scenes.push_back({ "tiles", tiles });
+
+	// Dozens of enemies chasing the player around a regular grid
+	LevelData* enemies = new LevelData();
+	addGrid(enemies, 48, 6, 48);
+	addEnemies(enemies, 48, 6, 8);
+	addEntry(enemies, "PLAYER", 120, 48 + 5 * BENCH_ROW_GAP - 8, 0);
+	scenes.push_back({ "enemies", enemies });
+
+	// Full ingredient columns, mostly at rest
+	LevelData* ingredients = new LevelData();
+	addGrid(ingredients, 48, 6, 48);
+	addIngredientColumns(ingredients, 48, 6);
+	addEnemies(ingredients, 48, 1, 4);
+	addEntry(ingredients, "PLAYER", 120, 48 + 5 * BENCH_ROW_GAP - 8, 0);
+	scenes.push_back({ "ingredients", ingredients });
+
+	// The player walks the top row, every drop pushes the whole column down
+	LevelData* cascade = new LevelData();
+	addGrid(cascade, 48, 6, 48);
+	addIngredientColumns(cascade, 48, 6);
+	addEntry(cascade, "PLAYER", 120, 48 - 8, 0);
+	scenes.push_back({ "cascade", cascade });
+
+	return scenes;
+}
+
+// Walks right, up, left and down in turns once the intro is over. The timings are in default-rate
+// ticks and scaled to the recording's rate, so the keys go down at the same game time at any rate
+InputRecording* createBenchInput(long ticks, int ticksPerSecond) {
+	InputRecording* input = new InputRecording(1, ticksPerSecond);
+	SDL_Keycode keys[] = { SDLK_RIGHT, SDLK_UP, SDLK_LEFT, SDLK_DOWN };
+	long intro = (long)BENCH_INTRO_TICKS * ticksPerSecond / SIMULATION_TICKS_PER_SECOND;
+	long period = (long)BENCH_INPUT_PERIOD * ticksPerSecond / SIMULATION_TICKS_PER_SECOND;
+	int turn = 0;
+
+	for (long tick = intro; tick + period < ticks; tick += period) {
+		SDL_Keycode key = keys[turn++ % 4];
+
+		input->addEvent({ (Uint32)tick, INPUT_KEY_DOWN, key, 0 });
+		input->addEvent({ (Uint32)(tick + period - 1), INPUT_KEY_UP, key, 0 });
+	}
+
+	input->setLength((Uint32)ticks);
+
+	return input;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <vector>
+#include "LevelData.h"
+#include "InputRecording.h"
+
+struct BenchScene {
+	const char* name;
+	LevelData* level;
+};
+
+std::vector<BenchScene> createBenchScenes();
+InputRecording* createBenchInput(long ticks, int ticksPerSecond);
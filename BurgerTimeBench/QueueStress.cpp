@@ -0,0 +1,139 @@
+#include "QueueStress.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+QueueStressReceiver::QueueStressReceiver() {
+	for (int i = 0; i < QUEUE_STRESS_PRODUCERS; i++) {
+		this->next[i] = 0;
+		this->received[i] = 0;
+	}
+
+	this->reordered = 0;
+}
+
+// Producer i posts ON_INGREDIENT_1 + i with its own sequence number as the value
+void QueueStressReceiver::receive(const Event& event) {
+	int producer = event.message - Message::ON_INGREDIENT_1;
+
+	if (event.value != this->next[producer]) {
+		this->reordered++;
+	}
+
+	this->next[producer] = event.value + 1;
+	this->received[producer]++;
+}
+
+long QueueStressReceiver::getReceived(int producer) {
+	return this->received[producer];
+}
+
+long QueueStressReceiver::getReordered() {
+	return this->reordered;
+}
+
+// A full queue drops the event, so the producer counts the drop and posts it again until it fits,
+// or until the consumer gives up on a stalled queue
+static void produce(MessageDispatcher* dispatcher, int producer, long events, long* drops, std::atomic<int>* finished,
+	std::atomic<bool>* stalled) {
+	Message message = (Message)(Message::ON_INGREDIENT_1 + producer);
+
+	for (long i = 0; i < events && !stalled->load(); i++) {
+		while (!dispatcher->postFromThread(message, (int)i)) {
+			(*drops)++;
+
+			if (stalled->load()) {
+				break;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	(*finished)++;
+}
+
+// Several threads post through postFromThread while this one drains and dispatches, as the main
+// thread does. Returns the number of failed checks: lost or reordered events, or drops that don't
+// match the queue's own count
+int stressEventQueue(long events) {
+	MessageDispatcher dispatcher;
+	QueueStressReceiver receiver;
+	std::vector<std::thread> threads;
+	std::atomic<int> finished(0);
+	std::atomic<bool> stalled(false);
+	Uint64 lastProgress = SDL_GetPerformanceCounter();
+	Uint64 stallCounts = QUEUE_STRESS_STALL_SECONDS * SDL_GetPerformanceFrequency();
+	long drops[QUEUE_STRESS_PRODUCERS] = {};
+	long perProducer = events / QUEUE_STRESS_PRODUCERS;
+	long totalDrops = 0;
+	int failures = 0;
+
+	for (int i = 0; i < QUEUE_STRESS_PRODUCERS; i++) {
+		dispatcher.subscribe((Message)(Message::ON_INGREDIENT_1 + i), &receiver);
+	}
+
+	for (int i = 0; i < QUEUE_STRESS_PRODUCERS; i++) {
+		threads.push_back(std::thread(produce, &dispatcher, i, perProducer, &drops[i], &finished, &stalled));
+	}
+
+	// Once every producer has finished, an empty drain means nothing is left in flight. A queue that
+	// hands out nothing for too long is wedged, and the producers are told to stop
+	for (;;) {
+		bool done = finished.load() == QUEUE_STRESS_PRODUCERS;
+		int drained = dispatcher.drainQueued();
+
+		dispatcher.dispatch();
+
+		if (drained > 0) {
+			lastProgress = SDL_GetPerformanceCounter();
+		}
+		else if (done) {
+			break;
+		}
+		else if (SDL_GetPerformanceCounter() - lastProgress > stallCounts) {
+			stalled.store(true);
+			break;
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	if (stalled.load()) {
+		printf("The queue delivered nothing for %d seconds\n\n", QUEUE_STRESS_STALL_SECONDS);
+		failures++;
+	}
+
+	printf("%-14s %12s %12s %12s\n", "producer", "posted", "received", "drops");
+
+	for (int i = 0; i < QUEUE_STRESS_PRODUCERS; i++) {
+		long received = receiver.getReceived(i);
+
+		printf("%-14d %12ld %12ld %12ld%s\n", i, perProducer, received, drops[i], received != perProducer ? "  LOST EVENTS" : "");
+		failures += received != perProducer ? 1 : 0;
+		totalDrops += drops[i];
+	}
+
+	if (receiver.getReordered() > 0) {
+		printf("\n%ld event(s) arrived out of their producer's order\n", receiver.getReordered());
+		failures++;
+	}
+
+	if (totalDrops != dispatcher.getQueueDropped()) {
+		printf("\nProducers saw %ld drop(s), the queue counted %ld\n", totalDrops, dispatcher.getQueueDropped());
+		failures++;
+	}
+
+	if (dispatcher.getQueueDepth() != 0) {
+		printf("\n%d event(s) were left in the queue\n", dispatcher.getQueueDepth());
+		failures++;
+	}
+
+	return failures;
+}
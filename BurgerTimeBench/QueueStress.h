@@ -0,0 +1,24 @@
+#pragma once
+#include "MessageDispatcher.h"
+#include "Receiver.h"
+
+const int QUEUE_STRESS_PRODUCERS = 4;
+const int QUEUE_STRESS_STALL_SECONDS = 5;
+
+// Subscribed to one message per producer, counts what arrives and what arrives out of order
+class QueueStressReceiver : public Receiver {
+	long next[QUEUE_STRESS_PRODUCERS];
+	long received[QUEUE_STRESS_PRODUCERS];
+	long reordered;
+
+public:
+	QueueStressReceiver();
+
+	using Receiver::receive;
+	virtual void receive(const Event& event);
+
+	long getReceived(int producer);
+	long getReordered();
+};
+
+int stressEventQueue(long events);
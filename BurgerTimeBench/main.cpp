@@ -0,0 +1,480 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <string>
+#include "Engine.h"
+#include "Game.h"
+#include "Constants.h"
+#include "PerformanceCounters.h"
+#include "BoxKernel.h"
+#include "BenchScenes.h"
+#include "QueueStress.h"
+
+typedef std::map<std::string, double> BenchResults;
+
+// Level loading and the first press of each bench key (a node in the engine's input maps) may
+// allocate. By this tick every key has been pressed once, later ticks are held to zero. Counted at
+// the default rate and scaled like the bench input
+const long ALLOCATION_WARMUP_TICKS = 900;
+
+const int KERNEL_BOXES = 256;
+const int KERNEL_QUERIES = 20000;
+
+Game* startScene(Engine* engine, BenchScene& scene, long ticks, int tickRate, bool profile) {
+	Game* game = new Game(engine);
+
+	game->setSharedLevel(scene.level);
+	engine->startReplay(createBenchInput(ticks, tickRate));
+	engine->setRenderWhenHeadless(true);
+	engine->getProfiler()->setEnabled(profile);
+	engine->initHeadless(game);
+
+	return game;
+}
+
+// Ingredients below the lowest floor or dish of the level have fallen through it
+int countLostIngredients(Game* game, LevelData* level) {
+	int bottom = 0;
+	int lost = 0;
+
+	for (LevelEntry& entry : *level) {
+		if (strcmp(entry.type, "FLOOR") == 0 || strcmp(entry.type, "DISH") == 0) {
+			bottom = std::max(bottom, entry.position[1]);
+		}
+	}
+
+	for (Entity* ingredient : *game->getIngredients()) {
+		lost += ingredient->getPosition().getY() > bottom ? 1 : 0;
+	}
+
+	return lost;
+}
+
+double timeScene(BenchScene& scene, long ticks, int tickRate, int* lostIngredients) {
+	Engine engine;
+	Game* game = startScene(&engine, scene, ticks, tickRate, false);
+	Uint64 start = SDL_GetPerformanceCounter();
+	long tick;
+
+	for (tick = 0; tick < ticks && engine.update(); tick++);
+
+	double nanoseconds = (double)(SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency();
+
+	*lostIngredients = countLostIngredients(game, scene.level);
+
+	delete game;
+
+	return tick > 0 ? nanoseconds / tick : 0;
+}
+
+// Heap allocations per tick once the scene has warmed up, including rendering into the draw list.
+// -1 when the scene ended before any tick past the warmup was measured
+double countSceneAllocations(BenchScene& scene, long ticks, int tickRate) {
+	Engine engine;
+	Game* game = startScene(&engine, scene, ticks, tickRate, false);
+	long warmup = ALLOCATION_WARMUP_TICKS * tickRate / SIMULATION_TICKS_PER_SECOND;
+	long tick;
+
+	for (tick = 0; tick < warmup && tick < ticks && engine.update(); tick++);
+
+	long start = PerformanceCounters::allocations;
+	long measured;
+
+	for (measured = 0; tick < ticks && engine.update(); tick++, measured++);
+
+	long allocations = PerformanceCounters::allocations - start;
+
+	delete game;
+
+	return measured > 0 ? (double)allocations / measured : -1;
+}
+
+// Reads one Itanium-mangled class name ("12PlayerEntity", "25WalkingRigidBodyComponentI12PlayerEntityE").
+// Returns false on anything else, such as non-type template arguments
+bool readMangledName(const char** cursor, std::string* name) {
+	size_t length = 0;
+
+	if (!isdigit((unsigned char)**cursor)) {
+		return false;
+	}
+
+	while (isdigit((unsigned char)**cursor)) {
+		length = length * 10 + (*(*cursor)++ - '0');
+	}
+
+	if (strlen(*cursor) < length) {
+		return false;
+	}
+
+	name->append(*cursor, length);
+	*cursor += length;
+
+	if (**cursor == 'I') {
+		(*cursor)++;
+		name->push_back('<');
+
+		for (bool first = true; **cursor != 'E'; first = false) {
+			if (!first) {
+				name->push_back(',');
+			}
+
+			if (!readMangledName(cursor, name)) {
+				return false;
+			}
+		}
+
+		(*cursor)++;
+		name->push_back('>');
+	}
+
+	return true;
+}
+
+// Scopes named by typeid differ per compiler ("12PlayerEntity" from GCC and Clang, "class PlayerEntity"
+// from MSVC). Results are keyed by the plain class name so one baseline compares on any toolchain
+std::string normalizeScopeName(const std::string& scope) {
+	const char* cursor = scope.c_str();
+	std::string name;
+
+	if (readMangledName(&cursor, &name) && *cursor == '\0') {
+		return name;
+	}
+
+	name.clear();
+
+	for (size_t i = 0; i < scope.size(); i++) {
+		if (scope.compare(i, 6, "class ") == 0) {
+			i += 5;
+		}
+		else if (scope.compare(i, 7, "struct ") == 0) {
+			i += 6;
+		}
+		else if (scope[i] != ' ') {
+			name.push_back(scope[i]);
+		}
+	}
+
+	return name;
+}
+
+void profileScene(BenchScene& scene, long ticks, int tickRate, BenchResults* results, bool fanOut) {
+	Engine engine;
+	Game* game = startScene(&engine, scene, ticks, tickRate, true);
+	Profiler* profiler = engine.getProfiler();
+	std::map<std::string, ProfileTotal> totals;
+	long tick = 0;
+	bool running = true;
+
+	// The profiler only keeps a ring of frames, so fold it into the totals before it wraps
+	while (running && tick < ticks) {
+		for (int frame = 0; frame < PROFILER_FRAMES && tick < ticks && running; frame++, tick++) {
+			running = engine.update();
+		}
+
+		profiler->addTotals(&totals);
+		profiler->reset();
+	}
+
+	for (auto& total : totals) {
+		(*results)[std::string(scene.name) + "/" + normalizeScopeName(total.first)] = tick > 0 ? profiler->countsToNanoseconds(total.second.counts) / tick : 0;
+	}
+
+	profiler->setEnabled(false);
+
+	if (fanOut) {
+		printf("\n%s\n", scene.name);
+		engine.getMessageDispatcher()->printFanOutStats();
+	}
+
+	delete game;
+}
+
+// Nanoseconds per box for one path of BoxKernel over a playfield of tile-sized boxes. The hit masks are
+// summed so every path can be checked against the scalar one
+double timeBoxKernel(BoxIntersector intersector, const PackedBoxes& boxes, Uint64* checksum) {
+	Uint64 hits[(KERNEL_BOXES + 63) / 64];
+	Uint64 sum = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (int query = 0; query < KERNEL_QUERIES; query++) {
+		intersector((query * 37) % 240, (query * 53) % 240, 16, 16, boxes, hits);
+
+		for (int word = 0; word < (KERNEL_BOXES + 63) / 64; word++) {
+			sum = sum * 31 + hits[word];
+		}
+	}
+
+	double nanoseconds = (double)(SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency();
+
+	*checksum = sum;
+
+	return nanoseconds / ((double)KERNEL_QUERIES * KERNEL_BOXES);
+}
+
+// Returns how many paths disagree with the scalar one
+int benchBoxKernel(BenchResults* results) {
+	std::vector<double> x, y, width, height;
+
+	for (int i = 0; i < KERNEL_BOXES; i++) {
+		x.push_back((i * 16) % 240 + 8);
+		y.push_back((i * 16 / 240) * 16 + 0.5 * (i % 3));
+		width.push_back(i % 4 == 0 ? 32 : 16);
+		height.push_back(i % 5 == 0 ? 2 : 16);
+	}
+
+	PackedBoxes boxes = { x.data(), y.data(), width.data(), height.data(), KERNEL_BOXES };
+	Uint64 scalarChecksum, checksum;
+	double scalar = timeBoxKernel(BoxKernel::intersectScalar, boxes, &scalarChecksum);
+	int mismatches = 0;
+
+	printf("\n%-14s %12s %9s\n", "box kernel", "ns/box", "speedup");
+	printf("%-14s %12.3f %8.2fx\n", "scalar", scalar, 1.0);
+	(*results)["kernel/scalar"] = scalar;
+
+	if (BoxKernel::isSse2Supported()) {
+		double sse2 = timeBoxKernel(BoxKernel::intersectSse2, boxes, &checksum);
+		mismatches += checksum != scalarChecksum ? 1 : 0;
+
+		printf("%-14s %12.3f %8.2fx%s\n", "sse2", sse2, scalar / sse2, checksum != scalarChecksum ? "  MISMATCH" : "");
+		(*results)["kernel/sse2"] = sse2;
+	}
+
+	if (BoxKernel::isAvxSupported()) {
+		double avx = timeBoxKernel(BoxKernel::intersectAvx, boxes, &checksum);
+		mismatches += checksum != scalarChecksum ? 1 : 0;
+
+		printf("%-14s %12.3f %8.2fx%s\n", "avx", avx, scalar / avx, checksum != scalarChecksum ? "  MISMATCH" : "");
+		(*results)["kernel/avx"] = avx;
+	}
+
+	printf("the game uses %s\n", BoxKernel::getPathName());
+
+	return mismatches;
+}
+
+bool writeResults(const char* path, BenchResults& results) {
+	FILE* fp = fopen(path, "w");
+	bool first = true;
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	fprintf(fp, "{\n");
+
+	for (auto& result : results) {
+		fprintf(fp, "%s  \"%s\": %.1f", first ? "" : ",\n", result.first.c_str(), result.second);
+		first = false;
+	}
+
+	fprintf(fp, "\n}\n");
+	fclose(fp);
+
+	return true;
+}
+
+bool readResults(const char* path, BenchResults* results) {
+	FILE* fp = fopen(path, "r");
+	char key[512];
+	double value;
+	int c;
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	// Only the flat "key": number objects written by writeResults are understood
+	while ((c = fgetc(fp)) != EOF) {
+		if (c == '"' && fscanf(fp, "%511[^\"]\" : %lf", key, &value) == 2) {
+			(*results)[key] = value;
+		}
+	}
+
+	fclose(fp);
+
+	return true;
+}
+
+// Per-scope metrics are everything but a scene's total and the box kernel timings
+bool isScopeMetric(const std::string& key) {
+	return key.compare(0, 7, "kernel/") != 0 && (key.size() < 6 || key.compare(key.size() - 6, 6, "/total") != 0);
+}
+
+int compareResults(BenchResults& results, BenchResults& baseline, double threshold, int* unmatchedScopes) {
+	int regressions = 0;
+	int missingFromBaseline = 0;
+	int missingFromResults = 0;
+
+	*unmatchedScopes = 0;
+
+	printf("\n%-60s %12s %12s %9s\n", "metric", "baseline", "current", "change");
+
+	for (auto& result : results) {
+		auto found = baseline.find(result.first);
+
+		if (found == baseline.end()) {
+			printf("%-60s %12s %12.1f  NOT IN BASELINE\n", result.first.c_str(), "-", result.second);
+			missingFromBaseline++;
+			*unmatchedScopes += isScopeMetric(result.first) ? 1 : 0;
+			continue;
+		}
+
+		if (found->second <= 0) {
+			continue;
+		}
+
+		std::string scene = result.first.substr(0, result.first.find('/'));
+		double sceneTotal = baseline[scene + "/total"];
+		double change = result.second / found->second - 1;
+
+		// Scopes under 1% of their scene are too noisy to judge
+		if (sceneTotal > 0 && found->second < sceneTotal * 0.01) {
+			continue;
+		}
+
+		bool regressed = change > threshold;
+		regressions += regressed ? 1 : 0;
+
+		printf("%-60s %12.1f %12.1f %+8.1f%%%s\n", result.first.c_str(), found->second, result.second, change * 100,
+			regressed ? "  REGRESSION" : "");
+	}
+
+	// Only scenes that ran this time can be missing their scopes
+	for (auto& entry : baseline) {
+		std::string scene = entry.first.substr(0, entry.first.find('/'));
+
+		if (results.find(entry.first) == results.end() && results.find(scene + "/total") != results.end()) {
+			printf("%-60s %12.1f %12s  NOT IN RESULTS\n", entry.first.c_str(), entry.second, "-");
+			missingFromResults++;
+		}
+	}
+
+	printf("\n%d metric(s) not in the baseline, %d baseline metric(s) not in the results\n", missingFromBaseline, missingFromResults);
+
+	return regressions;
+}
+
+int main(int argc, char* argv[]) {
+	long ticks = 3600;
+	const char* outputPath = "bench.json";
+	const char* baselinePath = nullptr;
+	const char* onlyScene = nullptr;
+	double threshold = 0.10;
+	bool fanOut = false;
+	int tickRate = SIMULATION_TICKS_PER_SECOND;
+	long queueStressEvents = 0;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--ticks") == 0) ticks = atol(argv[i + 1]);
+		else if (strcmp(argv[i], "--out") == 0) outputPath = argv[i + 1];
+		else if (strcmp(argv[i], "--baseline") == 0) baselinePath = argv[i + 1];
+		else if (strcmp(argv[i], "--scene") == 0) onlyScene = argv[i + 1];
+		else if (strcmp(argv[i], "--threshold") == 0) threshold = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--fanout") == 0) fanOut = atoi(argv[i + 1]) != 0;
+		else if (strcmp(argv[i], "--tick-rate") == 0) tickRate = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--queue-stress") == 0) queueStressEvents = atol(argv[i + 1]);
+	}
+
+	if (tickRate <= 0) {
+		printf("The tick rate must be positive\n");
+		return 2;
+	}
+
+	// A mode of its own: it checks the cross-thread event queue and times nothing
+	if (queueStressEvents > 0) {
+		int failures = stressEventQueue(queueStressEvents);
+		printf("\n%d queue check(s) failed\n", failures);
+
+		return failures > 0 ? 1 : 0;
+	}
+
+	std::vector<BenchScene> scenes = createBenchScenes();
+	BenchResults results;
+	int allocatingScenes = 0;
+	int unmeasuredScenes = 0;
+	int leakingScenes = 0;
+
+	printf("%-14s %8s %12s %12s\n", "scene", "entries", "ns/tick", "allocs/tick");
+
+	for (BenchScene& scene : scenes) {
+		if (onlyScene == nullptr || strcmp(onlyScene, scene.name) == 0) {
+			int lost;
+			double total = timeScene(scene, ticks, tickRate, &lost);
+
+			results[std::string(scene.name) + "/total"] = total;
+			profileScene(scene, ticks, tickRate, &results, fanOut);
+
+			double allocations = countSceneAllocations(scene, ticks, tickRate);
+			allocatingScenes += allocations > 0 ? 1 : 0;
+			unmeasuredScenes += allocations < 0 ? 1 : 0;
+			leakingScenes += lost > 0 ? 1 : 0;
+
+			printf("%-14s %8d %12.1f %12.3f%s%s\n", scene.name, (int)scene.level->size(), total, allocations,
+				allocations > 0 ? "  ALLOCATES" : allocations < 0 ? "  NOT MEASURED" : "", lost > 0 ? "  LOSES INGREDIENTS" : "");
+		}
+	}
+
+	int kernelMismatches = benchBoxKernel(&results);
+
+	if (!writeResults(outputPath, results)) {
+		printf("Could not write %s\n", outputPath);
+	}
+
+	for (BenchScene& scene : scenes) {
+		delete scene.level;
+	}
+
+	int status = 0;
+
+	// The steady-state tick must not touch the heap, whatever the timings say
+	if (allocatingScenes > 0) {
+		printf("\n%d scene(s) allocate in the steady-state tick\n", allocatingScenes);
+		status = 1;
+	}
+
+	if (unmeasuredScenes > 0) {
+		printf("\n%d scene(s) ran no ticks past the %ld warmup ticks, allocations were not measured\n", unmeasuredScenes, ALLOCATION_WARMUP_TICKS);
+		status = 1;
+	}
+
+	// At any tick rate, a falling ingredient must land instead of passing through the level
+	if (leakingScenes > 0) {
+		printf("\n%d scene(s) let ingredients fall through the level at %d ticks per second\n", leakingScenes, tickRate);
+		status = 1;
+	}
+
+	if (kernelMismatches > 0) {
+		printf("\n%d box kernel path(s) disagree with the scalar one\n", kernelMismatches);
+		status = 1;
+	}
+
+	if (baselinePath != nullptr) {
+		BenchResults baseline;
+
+		if (!readResults(baselinePath, &baseline)) {
+			printf("Could not read baseline %s\n", baselinePath);
+			return 2;
+		}
+
+		int unmatchedScopes;
+		int regressions = compareResults(results, baseline, threshold, &unmatchedScopes);
+		printf("%d regression(s) over %.0f%%\n", regressions, threshold * 100);
+
+		if (regressions > 0) {
+			status = 1;
+		}
+
+		// A scope the baseline doesn't know is never judged, so a stale baseline must not pass quietly
+		if (unmatchedScopes > 0) {
+			printf("\n%d profiled scope(s) are not in the baseline, regenerate it\n", unmatchedScopes);
+			status = 1;
+		}
+	}
+
+	return status;
+}